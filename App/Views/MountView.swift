@@ -21,8 +21,17 @@ final class MountFormModel {
     var busyThreshold = defaults.busyThreshold
     var graceSeconds = Int(defaults.graceSeconds)
     var queueTimeoutMs = defaults.queueTimeoutMs
+    var operationTimeout = Int(defaults.operationTimeout)
+    var readHedgePercent = defaults.readHedgePercent
     var cacheAttrSeconds = Int(defaults.cacheTimeout)
     var cacheDirSeconds = Int(defaults.dirCacheTimeout)
+    var cacheGraceSeconds = Int(defaults.cacheGraceTimeout)
+    var degradedMode = defaults.degradedMode
+    var writeJournalMB = defaults.writeJournalMB
+    /// `immutable_paths` patterns, separated by `;`.
+    var immutablePaths = defaults.immutablePaths.joined(separator: "; ")
+    /// `cache_rules` in their text form.
+    var cacheRules = defaults.cacheRules.map(\.formatted).joined(separator: "; ")
 
     func hydrate(from config: MountConfig) {
         hostAlias = config.hostAlias
@@ -50,26 +59,75 @@ final class MountFormModel {
         busyThreshold = opts.busyThreshold
         graceSeconds = Int(opts.graceSeconds.rounded())
         queueTimeoutMs = opts.queueTimeoutMs
+        operationTimeout = Int(opts.operationTimeout.rounded())
+        readHedgePercent = opts.readHedgePercent
         cacheAttrSeconds = Int(opts.cacheTimeout.rounded())
         cacheDirSeconds = Int(opts.dirCacheTimeout.rounded())
+        cacheGraceSeconds = Int(opts.cacheGraceTimeout.rounded())
+        degradedMode = opts.degradedMode
+        writeJournalMB = opts.writeJournalMB
+        immutablePaths = opts.immutablePaths.joined(separator: "; ")
+        cacheRules = opts.cacheRules.map(\.formatted).joined(separator: "; ")
 
         if opts.profile == .git {
             applyGitProfileOverrides()
         }
     }
 
+    /// Switch profiles from the picker. Worker counts start over from the new
+    /// profile's default; a loaded config keeps its own.
+    func selectProfile(_ newProfile: MountProfile) {
+        guard newProfile != profile else { return }
+        readWorkers = newProfile.defaultWorkers
+        writeWorkers = newProfile.defaultWorkers
+        profile = newProfile
+    }
+
     func applyGitProfileOverrides() {
-        readWorkers = 0
-        writeWorkers = 0
         ioMode = .blocking
-        cacheAttrSeconds = 0
-        cacheDirSeconds = 0
+        cacheAttrSeconds = min(cacheAttrSeconds, Int(MountOptions.gitCacheTimeoutRange.upperBound))
+        cacheDirSeconds = min(cacheDirSeconds, Int(MountOptions.gitCacheTimeoutRange.upperBound))
+        cacheGraceSeconds = 0
+        degradedMode = .off
+        writeJournalMB = 0
+        if immutablePaths.isEmpty {
+            immutablePaths = MountOptions.gitImmutablePaths.joined(separator: "; ")
+        }
         if healthFailures < 7 { healthFailures = 7 }
         if busyThreshold < 64 { busyThreshold = 64 }
     }
 
-    func currentOptions() -> MountOptions {
-        MountOptions(
+    /// Why `immutablePaths` does not parse, or nil if it does.
+    var immutablePathsError: String? {
+        do {
+            _ = try MountOptions.parsePatterns(immutablePaths)
+            return nil
+        } catch {
+            return error.localizedDescription
+        }
+    }
+
+    /// Why `cacheRules` does not parse, or nil if it does.
+    var cacheRulesError: String? {
+        do {
+            _ = try parsedCacheRules()
+            return nil
+        } catch {
+            return error.localizedDescription
+        }
+    }
+
+    /// `cacheRules` parsed with the TTL range of the selected profile, as the
+    /// CLI parses `cache_rules`.
+    private func parsedCacheRules() throws -> [CacheRule] {
+        try CacheRule.parseList(
+            cacheRules,
+            timeoutRange: profile == .git ? MountOptions.gitCacheTimeoutRange : MountOptions.cacheTimeoutRange
+        )
+    }
+
+    func currentOptions() throws -> MountOptions {
+        try MountOptions(
             profile: profile,
             readWorkers: readWorkers,
             writeWorkers: writeWorkers,
@@ -80,8 +138,15 @@ final class MountFormModel {
             busyThreshold: busyThreshold,
             graceSeconds: TimeInterval(graceSeconds),
             queueTimeoutMs: queueTimeoutMs,
+            operationTimeout: TimeInterval(operationTimeout),
+            readHedgePercent: readHedgePercent,
             cacheTimeout: TimeInterval(cacheAttrSeconds),
             dirCacheTimeout: TimeInterval(cacheDirSeconds),
+            cacheGraceTimeout: TimeInterval(cacheGraceSeconds),
+            degradedMode: degradedMode,
+            writeJournalMB: writeJournalMB,
+            immutablePaths: MountOptions.parsePatterns(immutablePaths),
+            cacheRules: parsedCacheRules(),
             authPassword: nil
         )
     }
@@ -110,7 +175,10 @@ struct MountView: View {
     }
 
     private var canSubmit: Bool {
-        hostAliasIsValid && !form.remotePath.trimmingCharacters(in: .whitespacesAndNewlines).isEmpty
+        hostAliasIsValid
+            && !form.remotePath.trimmingCharacters(in: .whitespacesAndNewlines).isEmpty
+            && form.immutablePathsError == nil
+            && form.cacheRulesError == nil
     }
 
     private var sshConfigPath: String {
@@ -287,7 +355,7 @@ struct MountView: View {
                         .font(.system(size: 12, weight: .semibold))
                         .foregroundStyle(.secondary)
 
-                    Picker("Profile", selection: $form.profile) {
+                    Picker("Profile", selection: Binding(get: { form.profile }, set: form.selectProfile)) {
                         ForEach(MountProfile.allCases, id: \.self) { profile in
                             Text(profile.displayName).tag(profile)
                         }
@@ -330,16 +398,14 @@ struct MountView: View {
                     Text("Read workers")
                         .font(.system(size: 12, weight: .medium))
                     Spacer()
-                    Stepper(form.profile == .git ? "Primary session" : "\(form.readWorkers)", value: $form.readWorkers, in: form.profile == .git ? 0...0 : form.profile.workerRange)
-                        .disabled(form.profile == .git)
+                    Stepper(form.readWorkers == 0 ? "Primary session" : "\(form.readWorkers)", value: $form.readWorkers, in: form.profile.workerRange)
                 }
 
                 HStack {
                     Text("Write workers")
                         .font(.system(size: 12, weight: .medium))
                     Spacer()
-                    Stepper(form.profile == .git ? "Primary session" : "\(form.writeWorkers)", value: $form.writeWorkers, in: form.profile == .git ? 0...0 : form.profile.workerRange)
-                        .disabled(form.profile == .git)
+                    Stepper(form.writeWorkers == 0 ? "Primary session" : "\(form.writeWorkers)", value: $form.writeWorkers, in: form.profile.workerRange)
                 }
 
                 HStack {
@@ -354,6 +420,14 @@ struct MountView: View {
                     .frame(width: 120)
                     .disabled(form.profile == .git)
                 }
+
+                HStack {
+                    Text("Read hedging")
+                        .font(.system(size: 12, weight: .medium))
+                    Spacer()
+                    Stepper(form.readHedgePercent == 0 ? "Off" : "\(form.readHedgePercent)%", value: $form.readHedgePercent, in: MountOptions.readHedgePercentRange)
+                        .disabled(form.readWorkers < 2)
+                }
             }
 
             Divider()
@@ -388,17 +462,75 @@ struct MountView: View {
                     Text("Attr cache")
                         .font(.system(size: 12, weight: .medium))
                     Spacer()
-                    Stepper("\(form.cacheAttrSeconds)s", value: $form.cacheAttrSeconds, in: 0...300)
-                        .disabled(form.profile == .git)
+                    Stepper("\(form.cacheAttrSeconds)s", value: $form.cacheAttrSeconds, in: form.profile == .git ? 0...1 : 0...300)
                 }
 
                 HStack {
                     Text("Dir cache")
                         .font(.system(size: 12, weight: .medium))
                     Spacer()
-                    Stepper("\(form.cacheDirSeconds)s", value: $form.cacheDirSeconds, in: 0...300)
+                    Stepper("\(form.cacheDirSeconds)s", value: $form.cacheDirSeconds, in: form.profile == .git ? 0...1 : 0...300)
+                }
+
+                HStack {
+                    Text("Stale grace")
+                        .font(.system(size: 12, weight: .medium))
+                    Spacer()
+                    Stepper(form.cacheGraceSeconds == 0 ? "Off" : "\(form.cacheGraceSeconds)s", value: $form.cacheGraceSeconds, in: 0...300)
                         .disabled(form.profile == .git)
                 }
+
+                HStack {
+                    Text("While reconnecting")
+                        .font(.system(size: 12, weight: .medium))
+                    Spacer()
+                    Picker("", selection: $form.degradedMode) {
+                        Text("Wait").tag(MountDegradedMode.off)
+                        Text("Serve cached").tag(MountDegradedMode.stale)
+                    }
+                    .pickerStyle(.menu)
+                    .frame(width: 120)
+                    .disabled(form.profile == .git)
+                }
+
+                HStack {
+                    Text("Write journal")
+                        .font(.system(size: 12, weight: .medium))
+                    Spacer()
+                    Stepper(
+                        form.writeJournalMB == 0 ? "Off" : "\(form.writeJournalMB) MiB",
+                        value: $form.writeJournalMB,
+                        in: MountOptions.writeJournalMBRange,
+                        step: 16
+                    )
+                    .disabled(form.profile == .git)
+                }
+
+                VStack(alignment: .leading, spacing: 4) {
+                    Text("Immutable paths")
+                        .font(.system(size: 12, weight: .medium))
+                    TextField("e.g. **/.git/objects/pack/pack-*.pack; vendor/**", text: $form.immutablePaths)
+                        .textFieldStyle(.plain)
+                        .font(.system(size: 11, design: .monospaced))
+                    if let error = form.immutablePathsError {
+                        Text(error)
+                            .font(.system(size: 11))
+                            .foregroundStyle(SSHMountTheme.danger)
+                    }
+                }
+
+                VStack(alignment: .leading, spacing: 4) {
+                    Text("Cache rules")
+                        .font(.system(size: 12, weight: .medium))
+                    TextField("e.g. vendor/**:attr=300,dir=300,content=on", text: $form.cacheRules)
+                        .textFieldStyle(.plain)
+                        .font(.system(size: 11, design: .monospaced))
+                    if let error = form.cacheRulesError {
+                        Text(error)
+                            .font(.system(size: 11))
+                            .foregroundStyle(SSHMountTheme.danger)
+                    }
+                }
             }
         }
         .padding(SSHMountTheme.outerPadding)
@@ -533,7 +665,7 @@ struct MountView: View {
             remotePath: form.remotePath.trimmingCharacters(in: .whitespacesAndNewlines),
             localPath: form.resolvedLocalPath,
             mountOnLaunch: form.mountOnLaunch,
-            options: form.currentOptions()
+            options: try form.currentOptions()
         )
     }
 
@@ -29,11 +29,11 @@ struct Mount: ParsableCommand {
     @Option(name: .long, help: "Profile: standard or git.")
     var profile: String = "standard"
 
-    @Option(name: .long, help: "Number of read worker sessions (1-8).")
-    var readWorkers: Int = 1
+    @Option(name: .long, help: "Number of read worker sessions (1-8, default 1; 0-8 with --profile git, default 0).")
+    var readWorkers: Int?
 
-    @Option(name: .long, help: "Number of write worker sessions (1-8).")
-    var writeWorkers: Int = 1
+    @Option(name: .long, help: "Number of write worker sessions (1-8, default 1; 0-8 with --profile git, default 0).")
+    var writeWorkers: Int?
 
     @Option(name: .long, help: "I/O mode: blocking or nonblocking.")
     var ioMode: String = "blocking"
@@ -56,12 +56,33 @@ struct Mount: ParsableCommand {
     @Option(name: .long, help: "Queue wait timeout in milliseconds (100-60000).")
     var queueTimeoutMs: Int = 2_000
 
+    @Option(name: .long, help: "Operation deadline in seconds; queued work older than this is dropped (1-300).")
+    var opTimeout: Int = 30
+
+    @Option(name: .long, help: "Hedged reads per 100 reads across read workers; 0 disables (0-50).")
+    var readHedgePct: Int = 0
+
     @Option(name: .long, help: "Attribute cache TTL in seconds (0-300).")
     var cacheAttr: Int = 5
 
     @Option(name: .long, help: "Directory cache TTL in seconds (0-300).")
     var cacheDir: Int = 5
 
+    @Option(name: .long, help: "Seconds an expired attribute is still served while it refreshes in the background (0-300).")
+    var cacheGrace: Int = 0
+
+    @Option(name: .long, help: "While reconnecting: off (wait) or stale (serve cached metadata, fail writes fast).")
+    var degradedMode: String = "off"
+
+    @Option(name: .long, help: "On-disk journal for writes issued while reconnecting, in MiB; 0 disables (0-1024).")
+    var writeJournalMb: Int = 0
+
+    @Option(name: .long, help: "Semicolon-separated patterns of content-addressed files cached until changed locally; empty disables (git profile default: git objects and packs).")
+    var immutablePaths: String?
+
+    @Option(name: .long, help: "Cache settings for a subtree, as <pattern>:attr=<s>,dir=<s>,neg=<s>,content=<on|off>,readahead_kb=<n>; repeat for more rules, the first match applies.")
+    var cacheRule: [String] = []
+
     @Flag(name: .shortAndLong, help: "Verbose output.")
     var verbose = false
 
@@ -106,7 +127,15 @@ struct Mount: ParsableCommand {
                 print("Health:      \(Int(options.healthInterval))s /\(Int(options.healthTimeout))s x\(options.healthFailures)")
                 print("Busy/Grace:  \(options.busyThreshold) / \(Int(options.graceSeconds))s")
                 print("Queue t/o:   \(options.queueTimeoutMs)ms")
-                print("Cache:       attr \(Int(options.cacheTimeout))s dir \(Int(options.dirCacheTimeout))s")
+                print("Op deadline: \(Int(options.operationTimeout))s")
+                print("Read hedge:  \(options.readHedgePercent)%")
+                print("Cache:       attr \(Int(options.cacheTimeout))s dir \(Int(options.dirCacheTimeout))s grace \(Int(options.cacheGraceTimeout))s")
+                print("Degraded:    \(options.degradedMode.rawValue)")
+                print("Journal:     \(options.writeJournalMB == 0 ? "off" : "\(options.writeJournalMB) MiB")")
+                print("Immutable:   \(options.immutablePaths.isEmpty ? "none" : options.immutablePaths.joined(separator: "; "))")
+                for rule in options.cacheRules {
+                    print("Cache rule:  \(rule.formatted)")
+                }
             }
             print("Resource URL: \(urlString)")
         }
@@ -126,10 +155,8 @@ struct Mount: ParsableCommand {
     }
 
     private func parsedOptions() throws -> MountOptions {
-        let dict: [String: String] = [
+        var dict: [String: String] = [
             "profile": profile,
-            "read_workers": String(readWorkers),
-            "write_workers": String(writeWorkers),
             "io_mode": ioMode,
             "health_interval_s": String(healthInterval),
             "health_timeout_s": String(healthTimeout),
@@ -137,9 +164,26 @@ struct Mount: ParsableCommand {
             "busy_threshold": String(busyThreshold),
             "grace_seconds": String(graceSeconds),
             "queue_timeout_ms": String(queueTimeoutMs),
+            "op_timeout_s": String(opTimeout),
+            "read_hedge_pct": String(readHedgePct),
             "cache_attr_s": String(cacheAttr),
             "cache_dir_s": String(cacheDir),
+            "cache_grace_s": String(cacheGrace),
+            "degraded_mode": degradedMode,
+            "write_journal_mb": String(writeJournalMb),
         ]
+        if let readWorkers {
+            dict["read_workers"] = String(readWorkers)
+        }
+        if let writeWorkers {
+            dict["write_workers"] = String(writeWorkers)
+        }
+        if let immutablePaths {
+            dict["immutable_paths"] = immutablePaths
+        }
+        if !cacheRule.isEmpty {
+            dict["cache_rules"] = cacheRule.joined(separator: ";")
+        }
         return try MountOptions(from: dict)
     }
 }
@@ -98,6 +98,16 @@ static inline int ssh2_sftp_fsync(LIBSSH2_SFTP_HANDLE *handle) {
     return libssh2_sftp_fsync(handle);
 }
 
+static inline int ssh2_sftp_fsetstat(LIBSSH2_SFTP_HANDLE *handle,
+                                     LIBSSH2_SFTP_ATTRIBUTES *attrs) {
+    return libssh2_sftp_fsetstat(handle, attrs);
+}
+
+static inline int ssh2_sftp_fstat(LIBSSH2_SFTP_HANDLE *handle,
+                                  LIBSSH2_SFTP_ATTRIBUTES *attrs) {
+    return libssh2_sftp_fstat(handle, attrs);
+}
+
 static inline int ssh2_sftp_posix_rename_ex(LIBSSH2_SFTP *sftp,
                                             const char *oldpath,
                                             unsigned int oldpath_len,
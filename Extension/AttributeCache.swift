@@ -1,58 +1,395 @@
 import Foundation
 import Synchronization
 
-/// Thread-safe time-based cache for SFTP attributes and directory listings.
+/// Thread-safe, bounded time-based cache for SFTP attributes and directory listings.
+///
+/// Entries are tagged with the reconnect epoch they were fetched in. After a
+/// reconnect the epoch advances: older entries are no longer served as fresh,
+/// but are kept so they can be revalidated by size and mtime instead of refetched.
+///
+/// Paths are spread over independently locked shards. Each shard holds a share
+/// of the cost budget (one unit per attribute entry, one plus one per child for
+/// a listing) and evicts with CLOCK once over it. A listing too large for its
+/// shard's share is charged to a mount-wide allowance for large entries
+/// instead, and is not cached while that is full. Expiry uses the monotonic
+/// clock; a one-second timer wheel drops entries in bulk once they are past
+/// expiry by more than `staleRetention`.
 @available(macOS 26.0, *)
-final class AttributeCache: Sendable {
+final class AttributeCache: @unchecked Sendable {
 
-    private struct CachedAttrs: Sendable {
-        let attrs: SFTPFileAttributes
-        let expiry: Date
+    /// Default total cost budget across all shards.
+    static let defaultBudget = 262_144
+
+    private static let shardCount = 16
+    private static let wheelSlots = 512
+
+    private enum Kind: Hashable, Sendable {
+        case attrs
+        case dirEntries
+        case missing
+    }
+
+    private struct Key: Hashable, Sendable {
+        let kind: Kind
+        let path: String
+    }
+
+    private enum Value: Sendable {
+        case attrs(SFTPFileAttributes)
+        /// `directoryModifiedAt` is the directory mtime when listed, if it can
+        /// prove the listing unchanged.
+        case dirEntries([SFTPDirectoryEntry], directoryModifiedAt: Date?)
+        /// A lookup found nothing at the path.
+        case missing
+    }
+
+    private struct Entry: Sendable {
+        var value: Value
+        var expiry: ContinuousClock.Instant
+        var epoch: UInt64
+        var cost: Int
+        var referenced = true
+        let slot: Int
+        var sweepTick: Int
     }
 
-    private struct CachedDirEntries: Sendable {
-        let entries: [SFTPDirectoryEntry]
-        let expiry: Date
+    private struct ShardState: ~Copyable {
+        var entries: [Key: Entry] = [:]
+        /// CLOCK ring of keys; nil marks a free slot.
+        var ring: [Key?] = []
+        var freeSlots: [Int] = []
+        var hand = 0
+        var cost = 0
+        /// Keys bucketed by the wheel tick at which they may be swept.
+        var wheel: [[Key]] = Array(repeating: [], count: AttributeCache.wheelSlots)
+        /// Paths with a background refresh in flight.
+        var refreshing: Set<String> = []
+        /// Files written through this volume and not yet reconciled with the server.
+        var localWrites: [String: LocalWrite] = [:]
     }
 
-    private struct State: ~Copyable {
-        var attrCache: [String: CachedAttrs] = [:]
-        var dirCache: [String: CachedDirEntries] = [:]
+    /// Lower bound on a file's size, and its mtime, from writes this volume has
+    /// made. Merged into attributes stored for the path, so a stat that raced a
+    /// write cannot roll the size back.
+    private struct LocalWrite: Sendable {
+        var size: UInt64
+        var modifiedAt: Date
     }
 
-    private let state = Mutex(State())
+    private final class Shard: Sendable {
+        let state = Mutex(ShardState())
+    }
+
+    private let shards: [Shard]
+    private let shardBudget: Int
+    /// Entries costing more than this are charged to `largeCost`, not their shard.
+    private let largeEntryCost: Int
+    private let largeBudget: Int
+    private let largeCost = Atomic<Int>(0)
+    private let staleRetention: Duration?
+    private let epoch = Atomic<UInt64>(0)
+    private let start = ContinuousClock.now
+    private let sweptTick = Mutex(0)
+    private let evictions = Atomic<Int>(0)
+    private let sweeps = Atomic<Int>(0)
+    private let sweepTimer: DispatchSourceTimer?
+
+    /// - Parameters:
+    ///   - budget: total cost across shards before CLOCK eviction starts.
+    ///   - staleRetention: how long past expiry an entry is kept for stale
+    ///     reads before the wheel sweeps it; nil keeps it until evicted.
+    init(budget: Int = AttributeCache.defaultBudget, staleRetention: Duration? = .zero) {
+        self.shards = (0..<Self.shardCount).map { _ in Shard() }
+        self.shardBudget = max(1, budget / Self.shardCount)
+        self.largeEntryCost = max(1, shardBudget / 4)
+        self.largeBudget = max(1, budget / 4)
+        self.staleRetention = staleRetention
+        if staleRetention != nil {
+            let timer = DispatchSource.makeTimerSource(queue: DispatchQueue(label: "com.sshmount.cache-sweep", qos: .utility))
+            timer.schedule(deadline: .now() + 1, repeating: 1, leeway: .milliseconds(250))
+            self.sweepTimer = timer
+        } else {
+            self.sweepTimer = nil
+        }
+        sweepTimer?.setEventHandler { [weak self] in
+            self?.sweep()
+        }
+        sweepTimer?.resume()
+    }
+
+    deinit {
+        sweepTimer?.cancel()
+    }
 
     // MARK: - Attribute Cache
 
-    /// Get cached attributes for a path, or nil if expired/missing.
+    /// Get cached attributes for a path, or nil if expired/missing/awaiting revalidation.
     func cachedAttrs(forPath path: String) -> SFTPFileAttributes? {
-        state.withLock { state in
-            guard let cached = state.attrCache[path], cached.expiry > Date() else { return nil }
-            return cached.attrs
-        }
+        let now = ContinuousClock.now
+        let current = epoch.load(ordering: .relaxed)
+        return lookup(Key(kind: .attrs, path: path)) { entry in
+            entry.epoch == current && entry.expiry > now
+        }.flatMap(Self.attrs)
+    }
+
+    /// Get cached attributes for a path even if expired, or nil if missing.
+    func staleAttrs(forPath path: String) -> SFTPFileAttributes? {
+        lookup(Key(kind: .attrs, path: path)) { _ in true }.flatMap(Self.attrs)
+    }
+
+    /// Attributes that expired less than `grace` seconds ago, or nil.
+    /// Entries awaiting revalidation after a reconnect are never served this way.
+    func attrsWithinGrace(forPath path: String, grace: TimeInterval) -> SFTPFileAttributes? {
+        let now = ContinuousClock.now
+        let current = epoch.load(ordering: .relaxed)
+        return lookup(Key(kind: .attrs, path: path)) { entry in
+            entry.epoch == current && entry.expiry.advanced(by: .seconds(grace)) > now
+        }.flatMap(Self.attrs)
+    }
+
+    /// Claim the background refresh of a path.
+    /// Returns false if one is already in flight.
+    func beginRefresh(forPath path: String) -> Bool {
+        shard(for: path).state.withLock { $0.refreshing.insert(path).inserted }
+    }
+
+    func endRefresh(forPath path: String) {
+        shard(for: path).state.withLock { _ = $0.refreshing.remove(path) }
+    }
+
+    /// Unexpired attributes cached before the last reconnect, or nil.
+    func attrsNeedingRevalidation(forPath path: String) -> SFTPFileAttributes? {
+        let now = ContinuousClock.now
+        let current = epoch.load(ordering: .relaxed)
+        return lookup(Key(kind: .attrs, path: path)) { entry in
+            entry.epoch != current && entry.expiry > now
+        }.flatMap(Self.attrs)
     }
 
     /// Store attributes for a path with a TTL.
-    func setAttrs(_ attrs: SFTPFileAttributes, forPath path: String, timeout: TimeInterval) {
-        state.withLock { state in
-            state.attrCache[path] = CachedAttrs(attrs: attrs, expiry: Date().addingTimeInterval(timeout))
+    /// - Returns: the attributes as stored, including unreconciled local writes.
+    @discardableResult
+    func setAttrs(_ attrs: SFTPFileAttributes, forPath path: String, timeout: TimeInterval) -> SFTPFileAttributes {
+        Self.attrs(store(.attrs(attrs), for: Key(kind: .attrs, path: path), cost: 1, timeout: timeout)) ?? attrs
+    }
+
+    // MARK: - Local Writes
+
+    /// Account for a completed write ending at `end` without asking the server:
+    /// the cached size grows to cover it, the mtime advances, and the entry's
+    /// TTL restarts. Holds until `reconcileLocalWrites` or invalidation.
+    func recordLocalWrite(forPath path: String, end: UInt64, timeout: TimeInterval) {
+        let key = Key(kind: .attrs, path: path)
+        let now = Date()
+        let expiry = ContinuousClock.now.advanced(by: .seconds(timeout))
+        let sweeping = staleRetention != nil
+        shard(for: path).state.withLock { state in
+            var local = state.localWrites[path] ?? LocalWrite(size: 0, modifiedAt: now)
+            local.size = max(local.size, end)
+            local.modifiedAt = now
+            state.localWrites[path] = local
+            guard var entry = state.entries[key], case .attrs(let attrs) = entry.value else { return }
+            entry.value = .attrs(Self.merging(attrs, with: local))
+            if expiry > entry.expiry {
+                entry.expiry = expiry
+                // Re-bucket like `store`, or the sweep drops the entry at its old tick.
+                let sweepTick = self.sweepTick(forExpiry: expiry)
+                if sweeping && entry.sweepTick != sweepTick {
+                    state.wheel[sweepTick % Self.wheelSlots].append(key)
+                }
+                entry.sweepTick = sweepTick
+            }
+            state.entries[key] = entry
+        }
+    }
+
+    /// Drop a file's local write accounting and its cached attributes, so the
+    /// next stat reads the server's view. Called at close and fsync.
+    /// - Returns: false if nothing was written locally.
+    @discardableResult
+    func reconcileLocalWrites(forPath path: String) -> Bool {
+        shard(for: path).state.withLock { state -> Bool in
+            guard state.localWrites.removeValue(forKey: path) != nil else { return false }
+            remove(Key(kind: .attrs, path: path), in: &state)
+            return true
+        }
+    }
+
+    /// `reconcileLocalWrites` for every file except those `keep` accepts.
+    func reconcileAllLocalWrites(keeping keep: (String) -> Bool = { _ in false }) {
+        for shard in shards {
+            shard.state.withLock { state in
+                for path in Array(state.localWrites.keys) where !keep(path) {
+                    state.localWrites.removeValue(forKey: path)
+                    remove(Key(kind: .attrs, path: path), in: &state)
+                }
+            }
         }
     }
 
     // MARK: - Directory Cache
 
-    /// Get cached directory entries for a path, or nil if expired/missing.
+    /// Get cached directory entries for a path, or nil if expired/missing/awaiting revalidation.
     func cachedDirEntries(forPath path: String) -> [SFTPDirectoryEntry]? {
-        state.withLock { state in
-            guard let cached = state.dirCache[path], cached.expiry > Date() else { return nil }
-            return cached.entries
+        let now = ContinuousClock.now
+        let current = epoch.load(ordering: .relaxed)
+        return lookup(Key(kind: .dirEntries, path: path)) { entry in
+            entry.epoch == current && entry.expiry > now
+        }.flatMap { Self.dirEntries($0)?.entries }
+    }
+
+    /// Get cached directory entries for a path even if expired, or nil if missing.
+    func staleDirEntries(forPath path: String) -> [SFTPDirectoryEntry]? {
+        lookup(Key(kind: .dirEntries, path: path)) { _ in true }.flatMap { Self.dirEntries($0)?.entries }
+    }
+
+    /// Unexpired listing cached before the last reconnect together with the
+    /// directory mtime it was listed at, or nil if it cannot be revalidated.
+    func dirEntriesNeedingRevalidation(forPath path: String) -> (entries: [SFTPDirectoryEntry], directoryModifiedAt: Date)? {
+        let now = ContinuousClock.now
+        let current = epoch.load(ordering: .relaxed)
+        let value = lookup(Key(kind: .dirEntries, path: path)) { entry in
+            entry.epoch != current && entry.expiry > now
+        }
+        guard let listing = value.flatMap(Self.dirEntries), let modifiedAt = listing.directoryModifiedAt else {
+            return nil
         }
+        return (listing.entries, modifiedAt)
     }
 
     /// Store directory entries for a path with a TTL.
-    func setDirEntries(_ entries: [SFTPDirectoryEntry], forPath path: String, timeout: TimeInterval) {
-        state.withLock { state in
-            state.dirCache[path] = CachedDirEntries(entries: entries, expiry: Date().addingTimeInterval(timeout))
+    ///
+    /// - Parameter directoryModifiedAt: the directory's mtime, read before listing.
+    ///   SFTP mtimes have one-second resolution, so an mtime within the last second
+    ///   could hide a later change and is not kept for revalidation.
+    func setDirEntries(
+        _ entries: [SFTPDirectoryEntry],
+        forPath path: String,
+        timeout: TimeInterval,
+        directoryModifiedAt: Date? = nil
+    ) {
+        let provableModifiedAt = directoryModifiedAt.flatMap { Date().timeIntervalSince($0) > 1 ? $0 : nil }
+        store(
+            .dirEntries(entries, directoryModifiedAt: provableModifiedAt),
+            for: Key(kind: .dirEntries, path: path),
+            cost: 1 + entries.count,
+            timeout: timeout
+        )
+    }
+
+    /// Store attributes for every child in a fresh listing of `dirPath`, so a
+    /// stat of any of them needs no round trip. Symlinks are skipped: the
+    /// listing describes the link, a stat its target.
+    /// - Parameter timeout: the TTL for a child path; children given 0 are skipped.
+    func setChildAttrs(ofDirectory dirPath: String, entries: [SFTPDirectoryEntry], timeout: (String) -> TimeInterval) {
+        let prefix = dirPath.hasSuffix("/") ? dirPath : dirPath + "/"
+        for entry in entries where !entry.isSymlink {
+            let path = prefix + entry.name
+            let ttl = timeout(path)
+            guard ttl > 0 else { continue }
+            let attrs = SFTPFileAttributes(
+                size: entry.size,
+                permissions: entry.permissions,
+                uid: entry.uid,
+                gid: entry.gid,
+                modifiedAt: entry.modifiedAt,
+                isDirectory: entry.isDirectory,
+                isSymlink: false
+            )
+            setAttrs(attrs, forPath: path, timeout: ttl)
+        }
+    }
+
+    // MARK: - Negative Cache
+
+    /// Whether a lookup of `path` found nothing within its TTL. Cleared by any
+    /// attributes stored for the path and by invalidation.
+    func isKnownMissing(_ path: String) -> Bool {
+        let now = ContinuousClock.now
+        let current = epoch.load(ordering: .relaxed)
+        return lookup(Key(kind: .missing, path: path)) { entry in
+            entry.epoch == current && entry.expiry > now
+        } != nil
+    }
+
+    func setMissing(forPath path: String, timeout: TimeInterval) {
+        store(.missing, for: Key(kind: .missing, path: path), cost: 1, timeout: timeout)
+    }
+
+    // MARK: - Revalidation
+
+    /// Start a new reconnect epoch. Every cached entry needs revalidation before
+    /// it is served as fresh again; stale reads still see it.
+    func beginRevalidationEpoch() {
+        epoch.add(1, ordering: .relaxed)
+    }
+
+    /// Mark a listing revalidated in the current epoch, keeping its entries and expiry.
+    func markDirEntriesRevalidated(forPath path: String) {
+        let current = epoch.load(ordering: .relaxed)
+        shard(for: path).state.withLock { state in
+            state.entries[Key(kind: .dirEntries, path: path)]?.epoch = current
+        }
+    }
+
+    /// Revalidate children's cached attributes against a current listing of
+    /// their directory. Children whose type, size, mode and mtime match keep
+    /// their data without a stat.
+    ///
+    /// - Returns: the number of attribute entries revalidated.
+    func revalidateChildren(ofDirectory dirPath: String, entries: [SFTPDirectoryEntry]) -> Int {
+        let prefix = dirPath.hasSuffix("/") ? dirPath : dirPath + "/"
+        let current = epoch.load(ordering: .relaxed)
+        var revalidated = 0
+        for entry in entries {
+            let key = Key(kind: .attrs, path: prefix + entry.name)
+            let matched = shard(for: key.path).state.withLock { state -> Bool in
+                guard let cached = state.entries[key], cached.epoch != current,
+                      case .attrs(let attrs) = cached.value,
+                      attrs.isDirectory == entry.isDirectory,
+                      attrs.isSymlink == entry.isSymlink,
+                      attrs.size == entry.size,
+                      attrs.permissions == entry.permissions,
+                      attrs.modifiedAt == entry.modifiedAt else { return false }
+                state.entries[key]?.epoch = current
+                return true
+            }
+            if matched {
+                revalidated += 1
+            }
+        }
+        return revalidated
+    }
+
+    // MARK: - Local Mutations
+
+    /// Patch a cached listing after a local mutation: replace or insert `entry`
+    /// by name, or remove `name` when `entry` is nil. The listing keeps its
+    /// expiry but drops its directory mtime, which the mutation changed.
+    ///
+    /// - Returns: false if no listing is cached for the directory.
+    @discardableResult
+    func patchDirEntries(inDirectory dirPath: String, name: String, with entry: SFTPDirectoryEntry?) -> Bool {
+        let key = Key(kind: .dirEntries, path: dirPath)
+        return shard(for: dirPath).state.withLock { state -> Bool in
+            guard var cached = state.entries[key], case .dirEntries(var entries, _) = cached.value else {
+                return false
+            }
+            let index = entries.firstIndex { $0.name == name }
+            switch (index, entry) {
+            case (let index?, let entry?):
+                entries[index] = entry
+            case (nil, let entry?):
+                entries.append(entry)
+            case (let index?, nil):
+                entries.remove(at: index)
+            case (nil, nil):
+                break
+            }
+            recharge(&cached, to: 1 + entries.count, in: &state)
+            cached.value = .dirEntries(entries, directoryModifiedAt: nil)
+            state.entries[key] = cached
+            return true
         }
     }
 
@@ -60,22 +397,267 @@ final class AttributeCache: Sendable {
 
     /// Invalidate cache entry for a path, optionally including its parent directory.
     func invalidate(_ path: String, includeParent: Bool = true) {
-        state.withLock { state in
-            state.attrCache.removeValue(forKey: path)
-            state.dirCache.removeValue(forKey: path)
-            if includeParent {
-                let parent = (path as NSString).deletingLastPathComponent
-                state.attrCache.removeValue(forKey: parent)
-                state.dirCache.removeValue(forKey: parent)
+        removeEntries(forPath: path)
+        if includeParent {
+            removeEntries(forPath: (path as NSString).deletingLastPathComponent)
+        }
+    }
+
+    /// Invalidate every entry below the directory `path`, after it moved.
+    func invalidate(descendantsOf path: String) {
+        let prefix = path.hasSuffix("/") ? path : path + "/"
+        for shard in shards {
+            shard.state.withLock { state in
+                for key in Array(state.entries.keys) where key.path.hasPrefix(prefix) {
+                    remove(key, in: &state)
+                }
+                for path in Array(state.localWrites.keys) where path.hasPrefix(prefix) {
+                    state.localWrites.removeValue(forKey: path)
+                }
+            }
+        }
+    }
+
+    /// Invalidate cached attributes for a path, keeping its listing.
+    func invalidateAttrs(_ path: String) {
+        shard(for: path).state.withLock { state in
+            remove(Key(kind: .attrs, path: path), in: &state)
+        }
+    }
+
+    // MARK: - Statistics
+
+    /// Entries evicted over budget and swept after expiry since the last call.
+    func takeEvictionCounts() -> (evicted: Int, swept: Int) {
+        (evictions.exchange(0, ordering: .relaxed), sweeps.exchange(0, ordering: .relaxed))
+    }
+
+    // MARK: - Private
+
+    private static func attrs(_ value: Value) -> SFTPFileAttributes? {
+        guard case .attrs(let attrs) = value else { return nil }
+        return attrs
+    }
+
+    private static func dirEntries(_ value: Value) -> (entries: [SFTPDirectoryEntry], directoryModifiedAt: Date?)? {
+        guard case .dirEntries(let entries, let modifiedAt) = value else { return nil }
+        return (entries, modifiedAt)
+    }
+
+    private func shard(for path: String) -> Shard {
+        shards[Int(UInt(bitPattern: path.hashValue) % UInt(shards.count))]
+    }
+
+    /// Return the entry's value if `isUsable` accepts it, marking it referenced.
+    private func lookup(_ key: Key, where isUsable: (Entry) -> Bool) -> Value? {
+        shard(for: key.path).state.withLock { state in
+            guard let entry = state.entries[key], isUsable(entry) else { return nil }
+            if !entry.referenced {
+                state.entries[key]?.referenced = true
+            }
+            return entry.value
+        }
+    }
+
+    /// Store or replace an entry. A large entry is returned uncached when the
+    /// large-entry allowance cannot take it.
+    @discardableResult
+    private func store(_ value: Value, for key: Key, cost: Int, timeout: TimeInterval) -> Value {
+        let expiry = ContinuousClock.now.advanced(by: .seconds(timeout))
+        let sweeping = staleRetention != nil
+        let sweepTick = self.sweepTick(forExpiry: expiry)
+        let current = epoch.load(ordering: .relaxed)
+        let budget = shardBudget
+        let (stored, evicted) = shard(for: key.path).state.withLock { state -> (Value, Int) in
+            var value = value
+            if case .attrs(let attrs) = value {
+                remove(Key(kind: .missing, path: key.path), in: &state)
+                if let local = state.localWrites[key.path] {
+                    value = .attrs(Self.merging(attrs, with: local))
+                }
+            }
+            let large = cost > largeEntryCost
+            if large || (state.entries[key]?.cost ?? 0) > largeEntryCost {
+                // Release the old charge before reserving the new one.
+                remove(key, in: &state)
+            }
+            if large {
+                guard reserveLargeCost(cost) else { return (value, 0) }
             }
+            if var entry = state.entries[key] {
+                state.cost += cost - entry.cost
+                entry.value = value
+                entry.expiry = expiry
+                entry.epoch = current
+                entry.cost = cost
+                entry.referenced = true
+                if sweeping && entry.sweepTick != sweepTick {
+                    state.wheel[sweepTick % Self.wheelSlots].append(key)
+                }
+                entry.sweepTick = sweepTick
+                state.entries[key] = entry
+            } else {
+                let slot: Int
+                if let free = state.freeSlots.popLast() {
+                    slot = free
+                    state.ring[slot] = key
+                } else {
+                    slot = state.ring.count
+                    state.ring.append(key)
+                }
+                state.entries[key] = Entry(
+                    value: value,
+                    expiry: expiry,
+                    epoch: current,
+                    cost: cost,
+                    slot: slot,
+                    sweepTick: sweepTick
+                )
+                if !large {
+                    state.cost += cost
+                }
+                if sweeping {
+                    state.wheel[sweepTick % Self.wheelSlots].append(key)
+                }
+            }
+            return (value, evictOverBudget(&state, budget: budget, keeping: key))
+        }
+        if evicted > 0 {
+            evictions.add(evicted, ordering: .relaxed)
+        }
+        return stored
+    }
+
+    /// Advance the CLOCK hand, giving referenced entries a second chance,
+    /// until the shard is within budget. `keeping` was just stored and large
+    /// entries are not charged to the shard, so neither is evicted.
+    private func evictOverBudget(_ state: inout ShardState, budget: Int, keeping kept: Key) -> Int {
+        var evicted = 0
+        while state.cost > budget, !state.entries.isEmpty {
+            if state.hand >= state.ring.count {
+                state.hand = 0
+            }
+            let position = state.hand
+            state.hand += 1
+            guard let key = state.ring[position], key != kept,
+                  let entry = state.entries[key], entry.cost <= largeEntryCost else { continue }
+            if entry.referenced {
+                state.entries[key]?.referenced = false
+                continue
+            }
+            remove(key, in: &state)
+            evicted += 1
+        }
+        return evicted
+    }
+
+    private func removeEntries(forPath path: String) {
+        shard(for: path).state.withLock { state in
+            remove(Key(kind: .attrs, path: path), in: &state)
+            remove(Key(kind: .dirEntries, path: path), in: &state)
+            remove(Key(kind: .missing, path: path), in: &state)
+            state.localWrites.removeValue(forKey: path)
+        }
+    }
+
+    private static func merging(_ attrs: SFTPFileAttributes, with local: LocalWrite) -> SFTPFileAttributes {
+        guard !attrs.isDirectory else { return attrs }
+        return SFTPFileAttributes(
+            size: max(attrs.size, local.size),
+            permissions: attrs.permissions,
+            uid: attrs.uid,
+            gid: attrs.gid,
+            modifiedAt: max(attrs.modifiedAt, local.modifiedAt),
+            isDirectory: attrs.isDirectory,
+            isSymlink: attrs.isSymlink
+        )
+    }
+
+    private func remove(_ key: Key, in state: inout ShardState) {
+        guard let entry = state.entries.removeValue(forKey: key) else { return }
+        state.ring[entry.slot] = nil
+        state.freeSlots.append(entry.slot)
+        if entry.cost > largeEntryCost {
+            largeCost.subtract(entry.cost, ordering: .relaxed)
+        } else {
+            state.cost -= entry.cost
         }
     }
 
-    /// Flush all caches (called after reconnection).
-    func invalidateAll() {
-        state.withLock { state in
-            state.attrCache.removeAll()
-            state.dirCache.removeAll()
+    /// Move an entry's charge to `cost`, between its shard and the large-entry
+    /// allowance as needed. A patched listing may overrun the allowance slightly.
+    private func recharge(_ entry: inout Entry, to cost: Int, in state: inout ShardState) {
+        if entry.cost > largeEntryCost {
+            largeCost.subtract(entry.cost, ordering: .relaxed)
+        } else {
+            state.cost -= entry.cost
+        }
+        if cost > largeEntryCost {
+            largeCost.add(cost, ordering: .relaxed)
+        } else {
+            state.cost += cost
+        }
+        entry.cost = cost
+    }
+
+    private func reserveLargeCost(_ cost: Int) -> Bool {
+        guard largeCost.add(cost, ordering: .relaxed).newValue <= largeBudget else {
+            largeCost.subtract(cost, ordering: .relaxed)
+            return false
+        }
+        return true
+    }
+
+    // MARK: - Timer Wheel
+
+    private func tick(at instant: ContinuousClock.Instant) -> Int {
+        Int((instant - start).components.seconds)
+    }
+
+    /// First whole tick at which the entry is past expiry plus retention.
+    /// Without retention nothing is swept, so the tick is irrelevant.
+    private func sweepTick(forExpiry expiry: ContinuousClock.Instant) -> Int {
+        guard let staleRetention else { return 0 }
+        return tick(at: expiry.advanced(by: staleRetention)) + 1
+    }
+
+    /// Sweep every tick elapsed since the last run. A bucket holds keys due on
+    /// later revolutions of the wheel, and keys whose entry was stored again
+    /// since; each is checked against its entry's current sweep tick.
+    private func sweep() {
+        let now = tick(at: .now)
+        let first = sweptTick.withLock { swept -> Int in
+            let first = swept + 1
+            swept = max(swept, now)
+            return first
+        }
+        guard first <= now else { return }
+        let ticks = max(first, now - Self.wheelSlots + 1)...now
+
+        var swept = 0
+        for shard in shards {
+            swept += shard.state.withLock { state -> Int in
+                var removed = 0
+                for tick in ticks {
+                    let bucket = tick % Self.wheelSlots
+                    let keys = Set(state.wheel[bucket])
+                    state.wheel[bucket].removeAll(keepingCapacity: true)
+                    for key in keys {
+                        guard let entry = state.entries[key] else { continue }
+                        if entry.sweepTick <= tick {
+                            remove(key, in: &state)
+                            removed += 1
+                        } else if entry.sweepTick % Self.wheelSlots == bucket {
+                            // Due on a later revolution.
+                            state.wheel[bucket].append(key)
+                        }
+                    }
+                }
+                return removed
+            }
+        }
+        if swept > 0 {
+            sweeps.add(swept, ordering: .relaxed)
         }
     }
 }
@@ -0,0 +1,63 @@
+import Foundation
+
+/// Cache settings in effect for one path.
+struct CachePolicy: Sendable {
+    var attrTimeout: TimeInterval
+    var dirTimeout: TimeInterval
+    /// 0 disables negative caching.
+    var negativeTimeout: TimeInterval
+    var contentCache: Bool
+    /// Bytes fetched past each read into the content cache.
+    var readAhead: Int
+}
+
+/// `cache_rules` compiled once per mount: each rule's pattern, with its
+/// settings already merged over the mount-wide ones, so finding the policy
+/// for a path only runs pattern matches and allocates nothing.
+struct CachePolicies: Sendable {
+
+    private struct Compiled: Sendable {
+        let glob: PathGlob
+        let policy: CachePolicy
+    }
+
+    /// The mount-wide settings, for paths no rule matches.
+    let base: CachePolicy
+    /// Whether any path caches attributes, listings or failed lookups.
+    let cachesMetadata: Bool
+    private let rules: [Compiled]
+
+    init(options: MountOptions) {
+        let base = CachePolicy(
+            attrTimeout: options.cacheTimeout,
+            dirTimeout: options.dirCacheTimeout,
+            negativeTimeout: 0,
+            contentCache: false,
+            readAhead: 0
+        )
+        let rules = options.cacheRules.compactMap { rule -> Compiled? in
+            guard let glob = PathGlob(rule.pattern) else { return nil }
+            let policy = CachePolicy(
+                attrTimeout: rule.attrTimeout ?? base.attrTimeout,
+                dirTimeout: rule.dirTimeout ?? base.dirTimeout,
+                negativeTimeout: rule.negativeTimeout ?? base.negativeTimeout,
+                contentCache: rule.contentCache ?? base.contentCache,
+                readAhead: (rule.readAheadKB ?? 0) * 1024
+            )
+            return Compiled(glob: glob, policy: policy)
+        }
+        self.base = base
+        self.rules = rules
+        self.cachesMetadata = ([base] + rules.map(\.policy)).contains {
+            $0.attrTimeout > 0 || $0.dirTimeout > 0 || $0.negativeTimeout > 0
+        }
+    }
+
+    /// The policy of the first rule matching `path`, relative to the mount root.
+    func policy(forRelativePath path: Substring) -> CachePolicy {
+        for rule in rules where rule.glob.matches(path) {
+            return rule.policy
+        }
+        return base
+    }
+}
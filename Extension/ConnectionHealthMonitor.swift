@@ -35,25 +35,24 @@ final class ConnectionHealthMonitor: @unchecked Sendable {
     // MARK: - Properties
 
     private var _state: State = .reconnecting
-    private let stateCondition = NSCondition()
+    private let stateLock = NSLock()
     private var running = false
 
     private(set) var state: State {
         get {
-            stateCondition.lock()
-            defer { stateCondition.unlock() }
+            stateLock.lock()
+            defer { stateLock.unlock() }
             return _state
         }
         set {
-            stateCondition.lock()
+            stateLock.lock()
             let old = _state
             guard old != newValue else {
-                stateCondition.unlock()
+                stateLock.unlock()
                 return
             }
             _state = newValue
-            stateCondition.broadcast()
-            stateCondition.unlock()
+            stateLock.unlock()
 
             Log.sftp.notice("ConnectionHealth: \(old.description, privacy: .public) -> \(newValue.description, privacy: .public)")
             onStateChanged?(newValue)
@@ -70,6 +69,8 @@ final class ConnectionHealthMonitor: @unchecked Sendable {
     var onReconnectNeeded: ((ReconnectReason) -> Bool)?
     var onSendSSHKeepalive: ((Int32) -> Bool)?
     var onSendSFTPProbe: ((Int32) -> Bool)?
+    /// Called on the monitor queue after each health snapshot is logged.
+    var onSnapshot: (() -> Void)?
 
     private let queue = DispatchQueue(label: "com.sshmount.health-monitor", qos: .utility)
     private var keepaliveTimer: DispatchSourceTimer?
@@ -128,9 +129,6 @@ final class ConnectionHealthMonitor: @unchecked Sendable {
             self.stopKeepaliveTimer()
             self.stopReconnectTimer()
             self.stopSnapshotTimer()
-            self.stateCondition.lock()
-            self.stateCondition.broadcast()
-            self.stateCondition.unlock()
         }
     }
 
@@ -185,21 +183,6 @@ final class ConnectionHealthMonitor: @unchecked Sendable {
         }
     }
 
-    // MARK: - Wait for Connected
-
-    func waitForConnected(timeout: TimeInterval) -> Bool {
-        let deadline = Date().addingTimeInterval(timeout)
-        stateCondition.lock()
-        defer { stateCondition.unlock() }
-
-        while _state != .connected && running {
-            if deadline.timeIntervalSinceNow <= 0 { return false }
-            stateCondition.wait(until: deadline)
-        }
-
-        return _state == .connected
-    }
-
     // MARK: - Keepalive
 
     private func startKeepaliveTimer() {
@@ -356,5 +339,6 @@ final class ConnectionHealthMonitor: @unchecked Sendable {
         Log.sftp.notice(
             "HealthSnapshot state=\(self.state.description, privacy: .public) inflight=\(self.inflightOperations, privacy: .public) ioAge=\(ioAge, privacy: .public)s probeRTT=\(rtt, privacy: .public)ms queueEWMA=\(queueWait, privacy: .public)ms reason=\(reason, privacy: .public)"
         )
+        onSnapshot?()
     }
 }
@@ -0,0 +1,185 @@
+import Foundation
+
+/// File data kept in fixed-size blocks, plus the attributes of files matched
+/// by `immutable_paths`.
+///
+/// Immutable files are content-addressed: once written, a path always holds
+/// the same bytes, so their entries never expire and survive reconnects. Other
+/// files (`content=on` cache rules) store their blocks under the size and
+/// mtime the file had when they were read. A block is only served for the same
+/// version, so the data stays valid for as long as the cached attributes do.
+/// Either way, everything for a path is dropped when it is deleted, renamed,
+/// created or written through this volume. Blocks are evicted with CLOCK once
+/// over the byte budget.
+final class ContentCache: @unchecked Sendable {
+
+    /// What a mutable file looked like when its blocks were read.
+    struct Version: Equatable {
+        let size: UInt64
+        let modifiedAt: Date
+
+        init(_ attrs: SFTPFileAttributes) {
+            self.size = attrs.size
+            self.modifiedAt = attrs.modifiedAt
+        }
+    }
+
+    /// Default data budget in bytes.
+    static let defaultBudget = 128 * 1024 * 1024
+    /// Attribute entries kept at most; an arbitrary one is dropped beyond it.
+    private static let maxAttrs = 65_536
+
+    private struct BlockKey: Hashable {
+        let path: String
+        let index: UInt64
+    }
+
+    private struct Block {
+        let data: Data
+        var referenced = true
+        let slot: Int
+    }
+
+    let blockSize: Int
+    private let budget: Int
+
+    private let lock = NSLock()
+    private var attrs: [String: SFTPFileAttributes] = [:]
+    private var blocks: [BlockKey: Block] = [:]
+    /// Block indexes cached per path, so a path is dropped without a scan.
+    private var blockIndexes: [String: Set<UInt64>] = [:]
+    /// Version of the cached blocks of each mutable file.
+    private var versions: [String: Version] = [:]
+    /// CLOCK ring of keys; nil marks a free slot.
+    private var ring: [BlockKey?] = []
+    private var freeSlots: [Int] = []
+    private var hand = 0
+    private var bytes = 0
+
+    init(blockSize: Int, budget: Int = ContentCache.defaultBudget) {
+        self.blockSize = blockSize
+        self.budget = budget
+    }
+
+    func attrs(forPath path: String) -> SFTPFileAttributes? {
+        lock.lock()
+        defer { lock.unlock() }
+        return attrs[path]
+    }
+
+    func setAttrs(_ value: SFTPFileAttributes, forPath path: String) {
+        lock.lock()
+        defer { lock.unlock() }
+        if attrs[path] == nil, attrs.count >= Self.maxAttrs {
+            attrs.remove(at: attrs.startIndex)
+        }
+        attrs[path] = value
+    }
+
+    /// The block at `index` (offset `index * blockSize`); shorter than
+    /// `blockSize` only at the end of the file. `version` is nil for
+    /// immutable files.
+    func block(path: String, index: UInt64, version: Version?) -> Data? {
+        lock.lock()
+        defer { lock.unlock() }
+        guard versions[path] == version else {
+            removePath(path)
+            return nil
+        }
+        let key = BlockKey(path: path, index: index)
+        guard var block = blocks[key] else { return nil }
+        if !block.referenced {
+            block.referenced = true
+            blocks[key] = block
+        }
+        return block.data
+    }
+
+    func setBlock(_ data: Data, path: String, index: UInt64, version: Version?) {
+        guard data.count <= budget else { return }
+        lock.lock()
+        defer { lock.unlock() }
+        if versions[path] != version {
+            removePath(path)
+            versions[path] = version
+        }
+        let key = BlockKey(path: path, index: index)
+        guard blocks[key] == nil else { return }
+        while bytes + data.count > budget, evictOne() {}
+
+        let slot: Int
+        if let free = freeSlots.popLast() {
+            slot = free
+            ring[slot] = key
+        } else {
+            slot = ring.count
+            ring.append(key)
+        }
+        blocks[key] = Block(data: data, slot: slot)
+        blockIndexes[path, default: []].insert(index)
+        bytes += data.count
+    }
+
+    /// Drop everything cached for `path`.
+    func remove(path: String) {
+        lock.lock()
+        defer { lock.unlock() }
+        attrs.removeValue(forKey: path)
+        removePath(path)
+    }
+
+    /// Drop everything cached below the directory `path`, after it moved.
+    func remove(descendantsOf path: String) {
+        let prefix = path.hasSuffix("/") ? path : path + "/"
+        lock.lock()
+        defer { lock.unlock() }
+        for key in Array(attrs.keys) where key.hasPrefix(prefix) {
+            attrs.removeValue(forKey: key)
+        }
+        for key in Set(versions.keys).union(blockIndexes.keys) where key.hasPrefix(prefix) {
+            removePath(key)
+        }
+    }
+
+    // MARK: - Private (lock held)
+
+    private func removePath(_ path: String) {
+        versions.removeValue(forKey: path)
+        guard let indexes = blockIndexes.removeValue(forKey: path) else { return }
+        for index in indexes {
+            removeBlock(BlockKey(path: path, index: index))
+        }
+    }
+
+    /// Advance the CLOCK hand to the next unreferenced block and evict it.
+    /// - Returns: false if nothing is cached.
+    private func evictOne() -> Bool {
+        guard !blocks.isEmpty else { return false }
+        while true {
+            if hand >= ring.count { hand = 0 }
+            defer { hand += 1 }
+            guard let key = ring[hand], var block = blocks[key] else { continue }
+            if block.referenced {
+                block.referenced = false
+                blocks[key] = block
+                continue
+            }
+            removeBlock(key)
+            if var indexes = blockIndexes[key.path] {
+                indexes.remove(key.index)
+                blockIndexes[key.path] = indexes.isEmpty ? nil : indexes
+                if indexes.isEmpty {
+                    versions.removeValue(forKey: key.path)
+                }
+            }
+            return true
+        }
+    }
+
+    private func removeBlock(_ key: BlockKey) {
+        guard let block = blocks.removeValue(forKey: key) else { return }
+        ring[block.slot] = nil
+        freeSlots.append(block.slot)
+        bytes -= block.data.count
+    }
+}
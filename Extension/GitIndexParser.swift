@@ -0,0 +1,116 @@
+import Foundation
+
+/// Incremental reader of the entry paths in a git index file (`.git/index`,
+/// format versions 2 to 4), fed the file's bytes in order as they are read.
+///
+/// Only paths are extracted. Bytes are kept until the entry they belong to is
+/// complete, so memory stays bounded by the largest read plus one entry.
+struct GitIndexParser {
+
+    enum ParseError: Error {
+        case notAnIndex
+        case unsupportedVersion(UInt32)
+        case malformed
+    }
+
+    /// Fixed-size part of an entry: ctime, mtime, dev, ino, mode, uid, gid,
+    /// size, object id and flags.
+    private static let entryHeaderSize = 62
+    /// More entries than this are taken as a corrupt header.
+    private static let maxEntries: UInt32 = 10_000_000
+
+    private var pending: [UInt8] = []
+    private var version: UInt32?
+    private var remainingEntries = 0
+    /// Version 4 compresses each path against the previous one.
+    private var previousPath: [UInt8] = []
+
+    /// True once every entry was read; later bytes belong to extensions.
+    var isComplete: Bool {
+        version != nil && remainingEntries == 0
+    }
+
+    /// Feed the next bytes of the file.
+    /// - Returns: the paths of the entries these bytes completed, in index order.
+    mutating func append(_ data: Data) throws -> [String] {
+        guard !isComplete else { return [] }
+        pending.append(contentsOf: data)
+
+        var position = 0
+        if version == nil {
+            guard pending.count >= 12 else { return [] }
+            guard pending[0..<4].elementsEqual("DIRC".utf8) else { throw ParseError.notAnIndex }
+            let fileVersion = Self.uint32(pending, at: 4)
+            guard (2...4).contains(fileVersion) else { throw ParseError.unsupportedVersion(fileVersion) }
+            let count = Self.uint32(pending, at: 8)
+            guard count <= Self.maxEntries else { throw ParseError.malformed }
+            version = fileVersion
+            remainingEntries = Int(count)
+            position = 12
+        }
+
+        var paths: [String] = []
+        while remainingEntries > 0, let entry = try nextEntry(at: position) {
+            paths.append(String(decoding: entry.path, as: UTF8.self))
+            position += entry.length
+            remainingEntries -= 1
+        }
+        pending.removeFirst(position)
+        if isComplete {
+            pending = []
+        }
+        return paths
+    }
+
+    /// The entry starting at `position`, or nil if it is not complete yet.
+    private mutating func nextEntry(at position: Int) throws -> (path: [UInt8], length: Int)? {
+        guard let version, position + Self.entryHeaderSize <= pending.count else { return nil }
+        let flags = UInt16(pending[position + 60]) << 8 | UInt16(pending[position + 61])
+        let extended = version >= 3 && flags & 0x4000 != 0
+        let nameStart = position + Self.entryHeaderSize + (extended ? 2 : 0)
+
+        if version == 4 {
+            // Bytes to drop from the previous path, then a NUL-terminated suffix.
+            guard let strip = try Self.offsetVarint(pending, at: nameStart) else { return nil }
+            guard strip.value <= previousPath.count else { throw ParseError.malformed }
+            let suffixStart = nameStart + strip.length
+            guard let end = pending[min(suffixStart, pending.count)...].firstIndex(of: 0) else { return nil }
+            let path = Array(previousPath.dropLast(strip.value)) + pending[suffixStart..<end]
+            previousPath = path
+            return (path, end + 1 - position)
+        }
+
+        // Versions 2 and 3: the name is NUL-padded so the entry fills a multiple of 8 bytes.
+        let nameLength: Int
+        if flags & 0x0FFF == 0x0FFF {
+            guard let end = pending[min(nameStart, pending.count)...].firstIndex(of: 0) else { return nil }
+            nameLength = end - nameStart
+        } else {
+            nameLength = Int(flags & 0x0FFF)
+        }
+        let length = (nameStart - position + nameLength + 8) & ~7
+        guard position + length <= pending.count else { return nil }
+        return (Array(pending[nameStart..<nameStart + nameLength]), length)
+    }
+
+    private static func uint32(_ bytes: [UInt8], at offset: Int) -> UInt32 {
+        bytes[offset..<offset + 4].reduce(0) { $0 << 8 | UInt32($1) }
+    }
+
+    /// Git's offset varint: seven bits per byte, most significant first, with
+    /// one added at each continuation. Nil if it runs past the available bytes.
+    private static func offsetVarint(_ bytes: [UInt8], at offset: Int) throws -> (value: Int, length: Int)? {
+        var index = offset
+        guard index < bytes.count else { return nil }
+        var byte = bytes[index]
+        var value = Int(byte & 0x7F)
+        while byte & 0x80 != 0 {
+            index += 1
+            guard index < bytes.count else { return nil }
+            guard index - offset < 8 else { throw ParseError.malformed }
+            byte = bytes[index]
+            value = ((value + 1) << 7) | Int(byte & 0x7F)
+        }
+        return (value, index + 1 - offset)
+    }
+}
@@ -0,0 +1,32 @@
+import Foundation
+
+/// Which sessions hold a cached or suspended file handle for each path.
+///
+/// Sessions report every change to their handle cache, so a close, remove or
+/// rename only has to reach the sessions that actually hold a handle for the
+/// path instead of queueing behind the work of every session.
+final class HandleRegistry: @unchecked Sendable {
+
+    private let lock = NSLock()
+    private var holders: [String: Set<ObjectIdentifier>] = [:]
+
+    /// Record whether `session` holds a handle for `path`.
+    func update(path: String, session: SFTPSession, holds: Bool) {
+        let id = ObjectIdentifier(session)
+        lock.lock()
+        defer { lock.unlock() }
+        if holds {
+            holders[path, default: []].insert(id)
+        } else if var sessions = holders[path] {
+            sessions.remove(id)
+            holders[path] = sessions.isEmpty ? nil : sessions
+        }
+    }
+
+    /// Whether `session` holds a handle for `path`.
+    func holds(path: String, session: SFTPSession) -> Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return holders[path]?.contains(ObjectIdentifier(session)) == true
+    }
+}
@@ -0,0 +1,142 @@
+import Foundation
+
+/// Sliding window of recent read latencies for one worker session.
+final class ReadLatencyTracker: @unchecked Sendable {
+    private static let windowSize = 128
+    private static let minimumSamples = 16
+
+    private let lock = NSLock()
+    private var samples: [Double] = []
+    private var nextIndex = 0
+
+    func record(milliseconds: Double) {
+        lock.lock()
+        defer { lock.unlock() }
+        if samples.count < Self.windowSize {
+            samples.append(milliseconds)
+        } else {
+            samples[nextIndex] = milliseconds
+        }
+        nextIndex = (nextIndex + 1) % Self.windowSize
+    }
+
+    /// 95th percentile of the window, or nil until enough reads have completed.
+    func p95Milliseconds() -> Double? {
+        lock.lock()
+        let window = samples
+        lock.unlock()
+        guard window.count >= Self.minimumSamples else { return nil }
+        let sorted = window.sorted()
+        let index = min(sorted.count - 1, Int((Double(sorted.count) * 0.95).rounded(.up)) - 1)
+        return sorted[index]
+    }
+}
+
+/// Token bucket that caps hedged reads at a fixed fraction of all reads.
+final class HedgeBudget: @unchecked Sendable {
+    private static let maxCredit = 10.0
+
+    private let ratio: Double
+    private let lock = NSLock()
+    private var credit = 0.0
+
+    /// - Parameter percent: hedges allowed per 100 reads.
+    init(percent: Int) {
+        self.ratio = Double(percent) / 100
+    }
+
+    func recordRead() {
+        lock.lock()
+        credit = min(Self.maxCredit, credit + ratio)
+        lock.unlock()
+    }
+
+    func tryConsume() -> Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        guard credit >= 1 else { return false }
+        credit -= 1
+        return true
+    }
+}
+
+/// Race between a read and its optional hedge on another worker session.
+/// The first successful attempt wins and the other is cancelled; an error is
+/// only reported once no attempt is left that could still succeed.
+final class HedgedReadRace: @unchecked Sendable {
+    enum Attempt: Sendable {
+        case primary
+        case hedge
+    }
+
+    enum Outcome {
+        case won(Data, Attempt)
+        case failed(Error)
+        case superseded
+    }
+
+    private let lock = NSLock()
+    private var finished = false
+    private var pending: Set<Attempt> = [.primary]
+    private var tokens: [Attempt: SFTPCancellationToken] = [:]
+    private var firstError: Error?
+
+    var isFinished: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return finished
+    }
+
+    /// Register a hedge attempt. Returns false if the race is already decided.
+    func beginHedge() -> Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        guard !finished else { return false }
+        pending.insert(.hedge)
+        return true
+    }
+
+    /// Called when an attempt reaches its worker. Returns false if it should not run.
+    func shouldStart(_ attempt: Attempt, token: SFTPCancellationToken) -> Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        guard !finished else {
+            pending.remove(attempt)
+            return false
+        }
+        tokens[attempt] = token
+        return true
+    }
+
+    func complete(_ attempt: Attempt, _ result: Result<Data, Error>) -> Outcome {
+        lock.lock()
+        pending.remove(attempt)
+        tokens.removeValue(forKey: attempt)
+        guard !finished else {
+            lock.unlock()
+            return .superseded
+        }
+        switch result {
+        case .success(let data):
+            finished = true
+            let losers = Array(tokens.values)
+            lock.unlock()
+            for token in losers {
+                token.cancel()
+            }
+            return .won(data, attempt)
+        case .failure(let error):
+            if firstError == nil {
+                firstError = error
+            }
+            guard pending.isEmpty else {
+                lock.unlock()
+                return .superseded
+            }
+            finished = true
+            let reported = firstError ?? error
+            lock.unlock()
+            return .failed(reported)
+        }
+    }
+}
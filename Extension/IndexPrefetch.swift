@@ -0,0 +1,159 @@
+import Foundation
+
+/// Directories to list ahead of `git status`, learned from git's own reads of
+/// `.git/index`.
+///
+/// Each index being read is followed from offset 0; reads that complete out
+/// of order on different sessions are held until the gap fills. The
+/// directories of the tracked paths it lists are queued once each and handed
+/// out a few at a time, so prefetching never holds more than `maxInFlight`
+/// scheduler slots next to git's own requests.
+final class IndexPrefetch: @unchecked Sendable {
+
+    private struct Follow {
+        var parser = GitIndexParser()
+        var nextOffset: Int64 = 0
+        /// Reads that completed ahead of an earlier one on another session.
+        var early: [Int64: Data] = [:]
+        /// Working tree the index belongs to.
+        let root: String
+    }
+
+    /// Listings in flight at once.
+    static let maxInFlight = 4
+    /// Directories queued at most; the rest of a larger index is skipped.
+    private static let maxQueued = 65_536
+    /// Indexes followed at once; reading another one drops the oldest.
+    private static let maxFollows = 8
+    /// Out-of-order reads held per index before the follow is given up.
+    private static let maxEarlyReads = 16
+
+    private let lock = NSLock()
+    private var follows: [String: Follow] = [:]
+    private var followOrder: [String] = []
+    private var queued: [String] = []
+    private var queueHead = 0
+    /// Directories queued since the queue last drained.
+    private var seen: Set<String> = []
+    private var inFlight = 0
+
+    /// Whether `path` names a git index file.
+    static func isIndex(_ path: String) -> Bool {
+        path.hasSuffix("/.git/index")
+    }
+
+    /// Feed the bytes git read from the index at `path`.
+    /// - Returns: the directories to list now.
+    func follow(indexPath path: String, offset: Int64, data: Data) -> [String] {
+        lock.lock()
+        defer { lock.unlock() }
+
+        if offset == 0, let current = follows[path], current.nextOffset > 0 {
+            stopFollow(path)
+        }
+        if follows[path] == nil {
+            let root = String(path.dropLast("/.git/index".count))
+            startFollow(path, root: root.isEmpty ? "/" : root)
+        }
+        guard var follow = follows[path] else { return [] }
+
+        if offset > follow.nextOffset {
+            guard follow.early.count < Self.maxEarlyReads else {
+                stopFollow(path)
+                return []
+            }
+            follow.early[offset] = data
+            follows[path] = follow
+            return []
+        }
+        guard offset == follow.nextOffset else {
+            stopFollow(path)
+            return []
+        }
+
+        var paths: [String] = []
+        var chunk: Data? = data
+        while let next = chunk {
+            do {
+                paths += try follow.parser.append(next)
+            } catch {
+                Log.volume.debug("Not prefetching from \(path, privacy: .public): \(String(describing: error), privacy: .public)")
+                stopFollow(path)
+                return []
+            }
+            follow.nextOffset += Int64(next.count)
+            chunk = follow.early.removeValue(forKey: follow.nextOffset)
+        }
+        if follow.parser.isComplete {
+            stopFollow(path)
+        } else {
+            follows[path] = follow
+        }
+
+        for entry in paths {
+            enqueueDirectories(of: entry, under: follow.root)
+        }
+        var start: [String] = []
+        while inFlight < Self.maxInFlight, let next = dequeue() {
+            inFlight += 1
+            start.append(next)
+        }
+        return start
+    }
+
+    /// Report that a listing handed out earlier finished, successfully or not.
+    /// - Returns: the next directory to list, if any.
+    func finish() -> String? {
+        lock.lock()
+        defer { lock.unlock() }
+        inFlight -= 1
+        guard let next = dequeue() else { return nil }
+        inFlight += 1
+        return next
+    }
+
+    // MARK: - Private (lock held)
+
+    private func startFollow(_ path: String, root: String) {
+        stopFollow(path)
+        if followOrder.count >= Self.maxFollows {
+            follows.removeValue(forKey: followOrder.removeFirst())
+        }
+        follows[path] = Follow(root: root)
+        followOrder.append(path)
+    }
+
+    private func stopFollow(_ path: String) {
+        guard follows.removeValue(forKey: path) != nil else { return }
+        followOrder.removeAll { $0 == path }
+    }
+
+    /// Queue the working-tree root and every directory on the way to `entry`.
+    private func enqueueDirectories(of entry: String, under root: String) {
+        var directory = root
+        for component in entry.split(separator: "/").dropLast() {
+            enqueue(directory)
+            directory = (directory as NSString).appendingPathComponent(String(component))
+        }
+        enqueue(directory)
+    }
+
+    private func enqueue(_ directory: String) {
+        guard queued.count - queueHead < Self.maxQueued, seen.insert(directory).inserted else { return }
+        queued.append(directory)
+    }
+
+    private func dequeue() -> String? {
+        guard queueHead < queued.count else {
+            if inFlight == 0 {
+                queued = []
+                queueHead = 0
+                seen = []
+            }
+            return nil
+        }
+        let next = queued[queueHead]
+        queueHead += 1
+        return next
+    }
+}
@@ -0,0 +1,56 @@
+import Foundation
+
+/// Files whose read-only handles were kept open after close, with the size and
+/// mtime they had at that point.
+///
+/// A handle refers to the file that was open, not to its path, so a lingering
+/// handle must not outlive a remote change: once a fresh stat of the path
+/// disagrees with the recorded attributes, the handles are dropped instead of
+/// being reused by the next open.
+final class LingeringHandles: @unchecked Sendable {
+
+    private struct Entry {
+        let size: UInt64
+        let modifiedAt: Date
+        let expiresAt: Date
+    }
+
+    /// Expired entries are pruned once this many accumulate.
+    private static let pruneThreshold = 1024
+
+    private let lock = NSLock()
+    private var entries: [String: Entry] = [:]
+
+    /// Record that handles for `path` linger until `expiresAt`.
+    func add(path: String, size: UInt64, modifiedAt: Date, expiresAt: Date) {
+        lock.lock()
+        defer { lock.unlock() }
+        if entries.count >= Self.pruneThreshold {
+            let now = Date()
+            entries = entries.filter { $0.value.expiresAt > now }
+        }
+        entries[path] = Entry(size: size, modifiedAt: modifiedAt, expiresAt: expiresAt)
+    }
+
+    /// Whether handles for `path` are lingering and `attrs` shows the file
+    /// changed since they were closed. The entry is dropped either way once it
+    /// has expired or changed.
+    func hasChanged(path: String, attrs: SFTPFileAttributes) -> Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        guard let entry = entries[path] else { return false }
+        if entry.expiresAt <= Date() {
+            entries.removeValue(forKey: path)
+            return false
+        }
+        guard entry.size != attrs.size || entry.modifiedAt != attrs.modifiedAt else { return false }
+        entries.removeValue(forKey: path)
+        return true
+    }
+
+    func remove(path: String) {
+        lock.lock()
+        defer { lock.unlock() }
+        entries.removeValue(forKey: path)
+    }
+}
@@ -0,0 +1,317 @@
+import Foundation
+
+/// Admission class of an FSKit operation. Each class has its own budget so
+/// bulk data transfers cannot starve interactive metadata calls.
+enum OperationClass: Int, CaseIterable, Sendable, CustomStringConvertible {
+    case metadata
+    case sync
+    case read
+    case write
+
+    var description: String {
+        switch self {
+        case .metadata: "metadata"
+        case .sync: "sync"
+        case .read: "read"
+        case .write: "write"
+        }
+    }
+}
+
+/// Per-class admission control with priority handoff.
+///
+/// Admission never blocks the caller: operations that cannot run immediately are
+/// parked in a bounded queue and admitted from `release(_:)` when capacity frees
+/// up, or rejected once their admission deadline passes.
+///
+/// When a slot frees up, metadata waiters are admitted first, then fsync/close,
+/// then reads and writes in alternation. Within the data classes, waiters are
+/// grouped per file and served by deficit round robin weighted by request size,
+/// so one large copy cannot monopolize the data budget.
+final class OperationScheduler: @unchecked Sendable {
+
+    struct Budgets: Sendable {
+        /// Maximum number of admitted operations across all classes.
+        let total: Int
+        /// Slots only metadata may use, so lookups still get through when data saturates.
+        let metadataReserve: Int
+        let perClass: [OperationClass: Int]
+        /// Maximum number of operations parked waiting for admission.
+        let maxParked: Int
+
+        init(total: Int) {
+            self.total = max(4, total)
+            self.maxParked = self.total * 4
+            self.metadataReserve = max(1, self.total / 8)
+            self.perClass = [
+                .metadata: self.total,
+                .sync: max(1, self.total / 4),
+                .read: max(1, self.total / 2),
+                .write: max(1, self.total / 2),
+            ]
+        }
+
+        func limit(for operationClass: OperationClass) -> Int {
+            perClass[operationClass] ?? total
+        }
+    }
+
+    enum Rejection: Sendable {
+        /// The admission deadline passed while the operation was parked.
+        case deadlineExpired
+        /// The park queue is full.
+        case overloaded
+        /// No slot was free and the operation was not allowed to park.
+        case busy
+    }
+
+    private final class Waiter {
+        let operationClass: OperationClass
+        let cost: Int
+        let deadline: DispatchTime
+        let onAdmit: () -> Void
+        let onReject: (Rejection) -> Void
+        var admitted = false
+        var cancelled = false
+
+        init(
+            operationClass: OperationClass,
+            cost: Int,
+            deadline: DispatchTime,
+            onAdmit: @escaping () -> Void,
+            onReject: @escaping (Rejection) -> Void
+        ) {
+            self.operationClass = operationClass
+            self.cost = cost
+            self.deadline = deadline
+            self.onAdmit = onAdmit
+            self.onReject = onReject
+        }
+    }
+
+    /// FIFO of waiters issued against one file.
+    private struct Flow {
+        var waiters: [Waiter] = []
+        var deficit = 0
+    }
+
+    /// Waiters of one class, kept per flow and served by deficit round robin.
+    private struct ClassQueue {
+        var flows: [String: Flow] = [:]
+        var activeFlows: [String] = []
+        var count = 0
+
+        mutating func enqueue(_ waiter: Waiter, flow key: String) {
+            if flows[key] == nil {
+                flows[key] = Flow()
+                activeFlows.append(key)
+            }
+            flows[key]!.waiters.append(waiter)
+            count += 1
+        }
+
+        mutating func dequeue(quantum: Int) -> Waiter? {
+            while let key = activeFlows.first, var flow = flows[key] {
+                while let head = flow.waiters.first, head.cancelled {
+                    flow.waiters.removeFirst()
+                }
+                guard let head = flow.waiters.first else {
+                    flows.removeValue(forKey: key)
+                    activeFlows.removeFirst()
+                    continue
+                }
+                if flow.deficit >= head.cost {
+                    flow.deficit -= head.cost
+                    flow.waiters.removeFirst()
+                    count -= 1
+                    if flow.waiters.isEmpty {
+                        flows.removeValue(forKey: key)
+                        activeFlows.removeFirst()
+                    } else {
+                        flows[key] = flow
+                    }
+                    return head
+                }
+                flow.deficit += quantum
+                flows[key] = flow
+                activeFlows.append(activeFlows.removeFirst())
+            }
+            return nil
+        }
+    }
+
+    let budgets: Budgets
+    private let quantum: Int
+    private let lock = NSLock()
+    private var inflight: [OperationClass: Int] = [:]
+    private var totalInflight = 0
+    private var queues: [OperationClass: ClassQueue] = [:]
+    private var preferWrites = false
+
+    /// Parked waiters in submission order, scanned when the deadline timer fires.
+    private var parked: [Waiter] = []
+    private var parkedCount = 0
+    private let timerQueue = DispatchQueue(label: "com.sshmount.admission-timer", qos: .userInitiated)
+    private var deadlineTimer: DispatchSourceTimer?
+    private var armedDeadline: DispatchTime?
+
+    /// - Parameter quantum: bytes a file may transfer per round-robin turn.
+    init(budgets: Budgets, quantum: Int) {
+        self.budgets = budgets
+        self.quantum = max(1, quantum)
+    }
+
+    deinit {
+        deadlineTimer?.cancel()
+    }
+
+    /// Admit an operation now, or park it until capacity frees up or `deadline` passes.
+    ///
+    /// Exactly one of `onAdmit` or `onReject` is called, possibly synchronously.
+    /// Neither is called with the scheduler lock held. After `onAdmit`, the caller
+    /// owns a slot and must balance it with `release(_:)`.
+    ///
+    /// - Parameters:
+    ///   - flow: fairness key within the class (the file path for data operations).
+    ///   - cost: request size in bytes; zero for metadata and sync operations.
+    ///   - parks: false for speculative work such as read-ahead, which is
+    ///     rejected with `.busy` rather than queued ahead of later requests.
+    func submit(
+        _ operationClass: OperationClass,
+        flow: String = "",
+        cost: Int = 0,
+        parks: Bool = true,
+        deadline: DispatchTime,
+        onAdmit: @escaping () -> Void,
+        onReject: @escaping (Rejection) -> Void
+    ) {
+        lock.lock()
+        if queues[operationClass, default: ClassQueue()].count == 0 && canAdmit(operationClass) {
+            admit(operationClass)
+            lock.unlock()
+            onAdmit()
+            return
+        }
+        guard parks else {
+            lock.unlock()
+            onReject(.busy)
+            return
+        }
+        guard parkedCount < budgets.maxParked else {
+            lock.unlock()
+            onReject(.overloaded)
+            return
+        }
+        let waiter = Waiter(
+            operationClass: operationClass,
+            cost: max(0, cost),
+            deadline: deadline,
+            onAdmit: onAdmit,
+            onReject: onReject
+        )
+        queues[operationClass, default: ClassQueue()].enqueue(waiter, flow: flow)
+        parked.append(waiter)
+        parkedCount += 1
+        armDeadlineTimer(for: deadline)
+        lock.unlock()
+    }
+
+    /// Return an admitted slot and hand it to the highest-priority waiters.
+    func release(_ operationClass: OperationClass) {
+        lock.lock()
+        inflight[operationClass, default: 1] -= 1
+        totalInflight -= 1
+        var admitted: [Waiter] = []
+        while let waiter = nextAdmissibleWaiter() {
+            parkedCount -= 1
+            admitted.append(waiter)
+        }
+        lock.unlock()
+
+        for waiter in admitted {
+            waiter.onAdmit()
+        }
+    }
+
+    // MARK: - Deadlines
+
+    private func armDeadlineTimer(for deadline: DispatchTime) {
+        if let armedDeadline, armedDeadline <= deadline { return }
+        armedDeadline = deadline
+        if deadlineTimer == nil {
+            let timer = DispatchSource.makeTimerSource(queue: timerQueue)
+            timer.setEventHandler { [weak self] in
+                self?.expireParkedWaiters()
+            }
+            timer.schedule(deadline: deadline)
+            timer.resume()
+            deadlineTimer = timer
+        } else {
+            deadlineTimer?.schedule(deadline: deadline)
+        }
+    }
+
+    private func expireParkedWaiters() {
+        let now = DispatchTime.now()
+        lock.lock()
+        var expired: [Waiter] = []
+        var next: DispatchTime?
+        parked.removeAll { waiter in
+            // Admitted waiters have already left their class queue.
+            if waiter.admitted { return true }
+            if waiter.deadline <= now {
+                waiter.cancelled = true
+                queues[waiter.operationClass]?.count -= 1
+                parkedCount -= 1
+                expired.append(waiter)
+                return true
+            }
+            next = min(next ?? waiter.deadline, waiter.deadline)
+            return false
+        }
+        armedDeadline = nil
+        if let next {
+            armDeadlineTimer(for: next)
+        }
+        lock.unlock()
+
+        for waiter in expired {
+            waiter.onReject(.deadlineExpired)
+        }
+    }
+
+    // MARK: - Private (lock held)
+
+    private func canAdmit(_ operationClass: OperationClass) -> Bool {
+        guard totalInflight < budgets.total,
+              inflight[operationClass, default: 0] < budgets.limit(for: operationClass) else {
+            return false
+        }
+        if operationClass == .metadata {
+            return true
+        }
+        return totalInflight < budgets.total - budgets.metadataReserve
+    }
+
+    private func admit(_ operationClass: OperationClass) {
+        inflight[operationClass, default: 0] += 1
+        totalInflight += 1
+    }
+
+    private func nextAdmissibleWaiter() -> Waiter? {
+        let order: [OperationClass] = preferWrites
+            ? [.metadata, .sync, .write, .read]
+            : [.metadata, .sync, .read, .write]
+        for operationClass in order where canAdmit(operationClass) {
+            guard queues[operationClass]?.count ?? 0 > 0,
+                  let waiter = queues[operationClass]?.dequeue(quantum: quantum) else { continue }
+            waiter.admitted = true
+            admit(operationClass)
+            if operationClass == .read || operationClass == .write {
+                preferWrites = operationClass == .read
+            }
+            return waiter
+        }
+        return nil
+    }
+}
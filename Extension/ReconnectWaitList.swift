@@ -0,0 +1,137 @@
+import Foundation
+
+/// Operations parked while the primary session reconnects.
+///
+/// Mirrors the health monitor: `hold()` on entering `.reconnecting`, `releaseAll()`
+/// on returning to `.connected`. Parked operations are resumed in park order, or
+/// expired individually once their own deadline passes. Nothing waits on a
+/// condition variable; a parked operation holds no thread.
+final class ReconnectWaitList: @unchecked Sendable {
+
+    private final class Entry {
+        let deadline: DispatchTime
+        let resume: () -> Void
+        let expire: () -> Void
+        var done = false
+
+        init(deadline: DispatchTime, resume: @escaping () -> Void, expire: @escaping () -> Void) {
+            self.deadline = deadline
+            self.resume = resume
+            self.expire = expire
+        }
+    }
+
+    private let lock = NSLock()
+    private var holding = false
+    private var entries: [Entry] = []
+    private let timerQueue = DispatchQueue(label: "com.sshmount.reconnect-wait", qos: .userInitiated)
+    private var deadlineTimer: DispatchSourceTimer?
+    private var armedDeadline: DispatchTime?
+
+    deinit {
+        deadlineTimer?.cancel()
+    }
+
+    var count: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return entries.count
+    }
+
+    /// Whether operations are being parked.
+    var isHolding: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return holding
+    }
+
+    /// Start parking operations (connection lost).
+    func hold() {
+        lock.lock()
+        holding = true
+        lock.unlock()
+    }
+
+    /// Stop parking and resume everything parked so far, in order.
+    func releaseAll() {
+        lock.lock()
+        holding = false
+        let released = entries.filter { !$0.done }
+        released.forEach { $0.done = true }
+        entries.removeAll()
+        armedDeadline = nil
+        lock.unlock()
+
+        for entry in released {
+            entry.resume()
+        }
+    }
+
+    /// Park an operation if the connection is currently held.
+    /// Returns false without parking when the connection is up.
+    func parkIfHolding(deadline: DispatchTime, resume: @escaping () -> Void, expire: @escaping () -> Void) -> Bool {
+        lock.lock()
+        guard holding else {
+            lock.unlock()
+            return false
+        }
+        appendLocked(Entry(deadline: deadline, resume: resume, expire: expire))
+        lock.unlock()
+        return true
+    }
+
+    /// Park an operation until the next `releaseAll()`, holding from now on.
+    /// Used after an operation itself observed a broken connection.
+    func park(deadline: DispatchTime, resume: @escaping () -> Void, expire: @escaping () -> Void) {
+        lock.lock()
+        holding = true
+        appendLocked(Entry(deadline: deadline, resume: resume, expire: expire))
+        lock.unlock()
+    }
+
+    // MARK: - Private
+
+    private func appendLocked(_ entry: Entry) {
+        entries.append(entry)
+        if let armedDeadline, armedDeadline <= entry.deadline { return }
+        armedDeadline = entry.deadline
+        if deadlineTimer == nil {
+            let timer = DispatchSource.makeTimerSource(queue: timerQueue)
+            timer.setEventHandler { [weak self] in
+                self?.expireEntries()
+            }
+            timer.schedule(deadline: entry.deadline)
+            timer.resume()
+            deadlineTimer = timer
+        } else {
+            deadlineTimer?.schedule(deadline: entry.deadline)
+        }
+    }
+
+    private func expireEntries() {
+        let now = DispatchTime.now()
+        lock.lock()
+        var expired: [Entry] = []
+        var next: DispatchTime?
+        entries.removeAll { entry in
+            if entry.done { return true }
+            if entry.deadline <= now {
+                entry.done = true
+                expired.append(entry)
+                return true
+            }
+            next = min(next ?? entry.deadline, entry.deadline)
+            return false
+        }
+        armedDeadline = nil
+        if let next {
+            armedDeadline = next
+            deadlineTimer?.schedule(deadline: next)
+        }
+        lock.unlock()
+
+        for entry in expired {
+            entry.expire()
+        }
+    }
+}
@@ -45,6 +45,8 @@ struct SFTPDirectoryEntry: Sendable, SFTPFileTyped {
     let isSymlink: Bool
     let size: UInt64
     let permissions: UInt32
+    let uid: UInt32
+    let gid: UInt32
     let modifiedAt: Date
 }
 
@@ -58,6 +60,50 @@ struct SFTPFileAttributes: Sendable, SFTPFileTyped {
     let isSymlink: Bool
 }
 
+// MARK: - Cancellation
+
+/// Deadline and cancellation flag for a single SFTP operation.
+/// Checked before a request reaches libssh2 and between chunks of a transfer.
+final class SFTPCancellationToken: @unchecked Sendable {
+    let deadline: DispatchTime?
+    private let lock = NSLock()
+    private var cancelled = false
+
+    init(deadline: DispatchTime? = nil) {
+        self.deadline = deadline
+    }
+
+    func cancel() {
+        lock.lock()
+        cancelled = true
+        lock.unlock()
+    }
+
+    /// True once cancelled explicitly or once the deadline has passed.
+    var isCancelled: Bool {
+        lock.lock()
+        let explicitlyCancelled = cancelled
+        lock.unlock()
+        if explicitlyCancelled { return true }
+        guard let deadline else { return false }
+        return DispatchTime.now() >= deadline
+    }
+
+    /// Milliseconds left before the deadline, or nil without one.
+    var remainingMs: Int? {
+        guard let deadline else { return nil }
+        let now = DispatchTime.now().uptimeNanoseconds
+        guard deadline.uptimeNanoseconds > now else { return 0 }
+        return Int((deadline.uptimeNanoseconds - now) / 1_000_000)
+    }
+
+    func check() throws {
+        if isCancelled {
+            throw POSIXError(.ECANCELED)
+        }
+    }
+}
+
 // MARK: - SFTP Session
 
 /// Wraps an SSH connection + SFTP subsystem using libssh2.
@@ -94,21 +140,61 @@ final class SFTPSession: @unchecked Sendable {
         let forWriting: Bool
         var dirty: Bool
         var lastUsed: Date
+        /// Set once the file was closed and this read-only handle is only kept
+        /// for a reopen; closed after this time.
+        var lingersUntil: Date? = nil
     }
 
     /// LRU cache of open SFTP file handles, keyed by remote path.
     private var handleCache: [String: CachedHandle] = [:]
+
+    /// Handle state carried across a reconnect so the handle can be reopened.
+    /// SFTP reads and writes carry explicit offsets, so no position is kept.
+    private struct SuspendedHandle {
+        let forWriting: Bool
+        let dirty: Bool
+    }
+
+    /// Handles that were open when the connection was torn down for a reconnect,
+    /// or dropped by a failed transfer with unsynced writes, keyed by remote path.
+    /// Reopened once a reconnect succeeds.
+    private var suspendedHandles: [String: SuspendedHandle] = [:]
     /// Maximum number of handles to keep open.
     private static let maxCachedHandles = 16
     private var didReportUnsupportedFsync = false
     private var isNonBlockingIO: Bool { ioMode == .nonBlocking }
 
+    /// Told about every path this session gains or loses a handle for. Set
+    /// once by the volume before any I/O.
+    var handleRegistry: HandleRegistry?
+    /// Set while `reconnect` moves handles between the cache and the suspended
+    /// set, so the registry only sees the outcome.
+    private var isReconnecting = false
+
+    /// Report whether this session still holds a cached or suspended handle for `path`.
+    private func reportHandle(_ path: String) {
+        guard !isReconnecting else { return }
+        handleRegistry?.update(
+            path: path,
+            session: self,
+            holds: handleCache[path] != nil || suspendedHandles[path] != nil
+        )
+    }
+
+    /// List this session as a holder of `path` before an OPEN goes out, so a
+    /// release or barrier that looks up holders while the OPEN is in flight
+    /// still queues behind it. `reportHandle` settles the entry afterwards.
+    private func reportOpening(_ path: String) {
+        guard !isReconnecting else { return }
+        handleRegistry?.update(path: path, session: self, holds: true)
+    }
+
     private func shouldRetryEAGAIN() -> Bool {
         guard isNonBlockingIO, let session = sshSession else { return false }
         return ssh2_session_last_errno(session) == SSH2_ERROR_EAGAIN
     }
 
-    private func waitSocketReady(timeoutMs: Int32 = 10_000) throws {
+    private func waitSocketReady(timeoutMs: Int32 = 10_000, cancellation: SFTPCancellationToken? = nil) throws {
         guard isNonBlockingIO, let session = sshSession, sock >= 0 else { return }
 
         let blockDirections = ssh2_session_block_directions(session)
@@ -123,9 +209,16 @@ final class SFTPSession: @unchecked Sendable {
             events = Int16(POLLIN | POLLOUT)
         }
 
+        // Never poll past the operation's own deadline.
+        var effectiveTimeout = timeoutMs
+        if let remaining = cancellation?.remainingMs {
+            effectiveTimeout = min(timeoutMs, Int32(clamping: max(1, remaining)))
+        }
+
         var fds = pollfd(fd: sock, events: events, revents: 0)
-        let pollRC = Darwin.poll(&fds, 1, timeoutMs)
+        let pollRC = Darwin.poll(&fds, 1, effectiveTimeout)
         if pollRC == 0 {
+            try cancellation?.check()
             throw POSIXError(.ETIMEDOUT)
         }
         if pollRC < 0 {
@@ -157,13 +250,18 @@ final class SFTPSession: @unchecked Sendable {
     /// Acquire a cached SFTP file handle, or open a new one.
     /// Caller must NOT close the returned handle — it is managed by the cache.
     func acquireHandle(path: String, forWriting: Bool) throws -> OpaquePointer {
+        closeExpiredLingeringHandles()
+
         // If we have a cached handle with compatible mode, reuse it
         if let cached = handleCache[path], cached.forWriting || !forWriting {
             var updated = cached
             updated.lastUsed = Date()
+            updated.lingersUntil = nil
             handleCache[path] = updated
             return cached.handle
         }
+        reportOpening(path)
+        defer { reportHandle(path) }
 
         // If there's a cached handle with wrong mode, close it first
         if let existing = handleCache.removeValue(forKey: path) {
@@ -175,11 +273,33 @@ final class SFTPSession: @unchecked Sendable {
             evictLRUHandle()
         }
 
+        // A handle suspended by a reconnect keeps its write mode and dirty flag.
+        let suspended = suspendedHandles.removeValue(forKey: path)
+        let handle = try openHandle(
+            path: path,
+            forWriting: forWriting || suspended?.forWriting == true,
+            create: suspended == nil
+        )
+        handleCache[path] = CachedHandle(
+            handle: handle,
+            forWriting: forWriting || suspended?.forWriting == true,
+            dirty: suspended?.dirty ?? false,
+            lastUsed: Date()
+        )
+        return handle
+    }
+
+    /// Open a file handle. Reopened handles never create the file, so a file
+    /// removed while disconnected is not silently recreated.
+    private func openHandle(path: String, forWriting: Bool, create: Bool) throws -> OpaquePointer {
         guard let sftp = sftpSession else { throw MountError.sftpError("No session") }
 
-        let flags: UInt = forWriting
-            ? UInt(LIBSSH2_FXF_READ | LIBSSH2_FXF_WRITE | LIBSSH2_FXF_CREAT)
+        var flags: UInt = forWriting
+            ? UInt(LIBSSH2_FXF_READ | LIBSSH2_FXF_WRITE)
             : UInt(LIBSSH2_FXF_READ)
+        if forWriting && create {
+            flags |= UInt(LIBSSH2_FXF_CREAT)
+        }
         let mode: Int = forWriting
             ? Int(LIBSSH2_SFTP_S_IRUSR | LIBSSH2_SFTP_S_IWUSR | LIBSSH2_SFTP_S_IRGRP | LIBSSH2_SFTP_S_IROTH)
             : 0
@@ -191,12 +311,6 @@ final class SFTPSession: @unchecked Sendable {
                 LIBSSH2_SFTP_OPENFILE
             )
             if let handle {
-                handleCache[path] = CachedHandle(
-                    handle: handle,
-                    forWriting: forWriting,
-                    dirty: false,
-                    lastUsed: Date()
-                )
                 return handle
             }
             if shouldRetryEAGAIN() {
@@ -207,15 +321,91 @@ final class SFTPSession: @unchecked Sendable {
         }
     }
 
+    /// Reopen handles suspended by the last reconnect. Best effort: a handle that
+    /// cannot be reopened now is retried lazily by `acquireHandle`.
+    private func reopenSuspendedHandles() {
+        var reopened = 0
+        for (path, suspended) in suspendedHandles {
+            guard handleCache.count < Self.maxCachedHandles else { break }
+            do {
+                let handle = try openHandle(path: path, forWriting: suspended.forWriting, create: false)
+                handleCache[path] = CachedHandle(
+                    handle: handle,
+                    forWriting: suspended.forWriting,
+                    dirty: suspended.dirty,
+                    lastUsed: Date()
+                )
+                suspendedHandles.removeValue(forKey: path)
+                reopened += 1
+            } catch {
+                Log.sftp.notice("Handle reopen after reconnect failed for \(path, privacy: .public): \(error.localizedDescription, privacy: .public)")
+                if !suspended.dirty {
+                    suspendedHandles.removeValue(forKey: path)
+                    reportHandle(path)
+                }
+            }
+        }
+        if reopened > 0 {
+            Log.sftp.debug("Reopened \(reopened, privacy: .public) handles after reconnect")
+        }
+    }
+
     /// Release a cached handle for a specific path (called on closeItem).
     func releaseHandle(path: String) {
+        suspendedHandles.removeValue(forKey: path)
         if let entry = handleCache.removeValue(forKey: path) {
             closeFileHandle(entry.handle)
         }
+        reportHandle(path)
+    }
+
+    /// Called on closeItem instead of `releaseHandle` when a reopen is likely:
+    /// a read-only handle stays cached until `deadline` so the reopen skips
+    /// OPEN. Write handles are released as usual.
+    func lingerHandle(path: String, until deadline: Date) {
+        guard var entry = handleCache[path], !entry.forWriting else {
+            releaseHandle(path: path)
+            return
+        }
+        suspendedHandles.removeValue(forKey: path)
+        entry.lingersUntil = deadline
+        handleCache[path] = entry
+    }
+
+    /// Close the handle for `path` if it is only lingering after a close,
+    /// e.g. because the file changed on the server.
+    func dropLingeringHandle(path: String) {
+        guard handleCache[path]?.lingersUntil != nil else { return }
+        releaseHandle(path: path)
+    }
+
+    /// Close lingering handles whose linger period has passed.
+    func closeExpiredLingeringHandles() {
+        let now = Date()
+        for (path, entry) in handleCache {
+            if let deadline = entry.lingersUntil, deadline <= now {
+                releaseHandle(path: path)
+            }
+        }
+    }
+
+    /// Drop a handle after a failed or aborted transfer. Unsynced writes are
+    /// remembered so the next open of the path still fsyncs them.
+    private func discardHandle(path: String) {
+        guard let entry = handleCache.removeValue(forKey: path) else { return }
+        closeFileHandle(entry.handle)
+        if entry.dirty {
+            suspendedHandles[path] = SuspendedHandle(forWriting: true, dirty: true)
+        }
+        reportHandle(path)
     }
 
     /// Flush buffered server-side state for a specific open write handle if needed.
     func syncHandle(path: String) throws {
+        if handleCache[path] == nil, suspendedHandles[path]?.dirty == true {
+            // Unsynced writes from before a reconnect: reopen so the fsync still happens.
+            _ = try acquireHandle(path: path, forWriting: true)
+        }
         guard var entry = handleCache[path], entry.forWriting else { return }
         guard entry.dirty else { return }
         let rc = try withEAGAINRetry { ssh2_sftp_fsync(entry.handle) }
@@ -242,17 +432,22 @@ final class SFTPSession: @unchecked Sendable {
 
     /// Flush all dirty write handles currently cached in this session.
     func syncAllWriteHandles() throws {
-        for path in Array(handleCache.keys) {
+        for path in Set(handleCache.keys).union(suspendedHandles.keys) {
             try syncHandle(path: path)
         }
     }
 
-    /// Close all cached handles (called before disconnect/reconnect).
+    /// Close all cached handles (called before disconnect).
     func releaseAllHandles() {
+        let paths = Set(handleCache.keys).union(suspendedHandles.keys)
         for entry in handleCache.values {
             closeFileHandle(entry.handle)
         }
         handleCache.removeAll()
+        suspendedHandles.removeAll()
+        for path in paths {
+            reportHandle(path)
+        }
     }
 
     /// Evict the least-recently-used handle.
@@ -260,6 +455,7 @@ final class SFTPSession: @unchecked Sendable {
         guard let oldest = handleCache.min(by: { $0.value.lastUsed < $1.value.lastUsed }) else { return }
         closeFileHandle(oldest.value.handle)
         handleCache.removeValue(forKey: oldest.key)
+        reportHandle(oldest.key)
     }
 
     init(
@@ -500,14 +696,39 @@ final class SFTPSession: @unchecked Sendable {
     /// Tear down the existing connection and make a single reconnect attempt.
     /// The caller (ConnectionHealthMonitor) handles retry scheduling with
     /// exponential backoff, so this method must NOT retry internally.
+    ///
+    /// Open file handles survive the reconnect: their path, mode and dirty
+    /// state are recorded before teardown (and kept across failed attempts)
+    /// and the handles are reopened once the session is back.
     func reconnect() throws {
+        let heldBefore = Set(handleCache.keys).union(suspendedHandles.keys)
+        isReconnecting = true
+        defer {
+            isReconnecting = false
+            for path in heldBefore.union(handleCache.keys).union(suspendedHandles.keys) {
+                reportHandle(path)
+            }
+        }
+
+        // Lingering handles belong to closed files; they are simply dropped.
+        for (path, entry) in handleCache where entry.lingersUntil == nil {
+            let previous = suspendedHandles[path]
+            suspendedHandles[path] = SuspendedHandle(
+                forWriting: entry.forWriting || previous?.forWriting == true,
+                dirty: entry.dirty || previous?.dirty == true
+            )
+        }
+        let suspended = suspendedHandles
         disconnect()
+        suspendedHandles = suspended
         do {
             try connect(authMethods: storedAuthMethods)
         } catch {
             disconnect()
+            suspendedHandles = suspended
             throw error
         }
+        reopenSuspendedHandles()
     }
 
     // MARK: - Authentication Helpers
@@ -588,6 +809,8 @@ final class SFTPSession: @unchecked Sendable {
                 isSymlink: isSymlink,
                 size: attrs.filesize,
                 permissions: UInt32(attrs.permissions & 0o7777),
+                uid: UInt32(attrs.uid),
+                gid: UInt32(attrs.gid),
                 modifiedAt: Date(timeIntervalSince1970: TimeInterval(attrs.mtime))
             )
             entries.append(entry)
@@ -604,11 +827,26 @@ final class SFTPSession: @unchecked Sendable {
 
     // MARK: - File Operations
 
-    func readFile(path: String, offset: UInt64, length: Int, into buffer: UnsafeMutableRawBufferPointer) throws -> Int {
+    /// Abort a transfer whose token was cancelled. Closing the handle discards
+    /// libssh2's outstanding pipelined requests for it.
+    private func abortTransfer(path: String, cancellation: SFTPCancellationToken?) throws {
+        guard let cancellation, cancellation.isCancelled else { return }
+        discardHandle(path: path)
+        throw POSIXError(.ECANCELED)
+    }
+
+    func readFile(
+        path: String,
+        offset: UInt64,
+        length: Int,
+        into buffer: UnsafeMutableRawBufferPointer,
+        cancellation: SFTPCancellationToken? = nil
+    ) throws -> Int {
         let requestedLength = min(length, buffer.count)
         guard requestedLength > 0 else { return 0 }
         guard let bufferBase = buffer.baseAddress else { return 0 }
 
+        try cancellation?.check()
         let handle = try acquireHandle(path: path, forWriting: false)
 
         libssh2_sftp_seek64(handle, offset)
@@ -620,15 +858,19 @@ final class SFTPSession: @unchecked Sendable {
             let base = bufferBase.advanced(by: totalRead)
             let rc = libssh2_sftp_read(handle, base.assumingMemoryBound(to: CChar.self), remaining)
             if rc == Int(SSH2_ERROR_EAGAIN) {
-                try waitSocketReady()
+                try abortTransfer(path: path, cancellation: cancellation)
+                try waitSocketReady(cancellation: cancellation)
                 continue
             }
             if rc < 0 {
-                releaseHandle(path: path)
+                discardHandle(path: path)
                 throw sftpError("read failed for \(path)")
             }
             if rc == 0 { break } // EOF
             totalRead += rc
+            if totalRead < requestedLength {
+                try abortTransfer(path: path, cancellation: cancellation)
+            }
         }
 
         return totalRead
@@ -646,7 +888,8 @@ final class SFTPSession: @unchecked Sendable {
         return data
     }
 
-    func writeFile(path: String, offset: UInt64, data: Data) throws -> Int {
+    func writeFile(path: String, offset: UInt64, data: Data, cancellation: SFTPCancellationToken? = nil) throws -> Int {
+        try cancellation?.check()
         let handle = try acquireHandle(path: path, forWriting: true)
 
         libssh2_sftp_seek64(handle, offset)
@@ -659,15 +902,19 @@ final class SFTPSession: @unchecked Sendable {
                 return libssh2_sftp_write(handle, base.assumingMemoryBound(to: CChar.self), remaining)
             }
             if rc == Int(SSH2_ERROR_EAGAIN) {
-                try waitSocketReady()
+                try abortTransfer(path: path, cancellation: cancellation)
+                try waitSocketReady(cancellation: cancellation)
                 continue
             }
             if rc < 0 {
-                releaseHandle(path: path)
+                discardHandle(path: path)
                 throw sftpError("write failed for \(path)")
             }
             if rc == 0 { break }
             totalWritten += rc
+            if totalWritten < data.count {
+                try abortTransfer(path: path, cancellation: cancellation)
+            }
         }
 
         if var entry = handleCache[path] {
@@ -679,17 +926,47 @@ final class SFTPSession: @unchecked Sendable {
         return totalWritten
     }
 
-    func createFile(path: String, permissions: Int = 0o644) throws {
+    /// Create or truncate a file. With `keepOpen`, the new handle goes into the
+    /// handle cache for the writes that usually follow, sparing a CLOSE and a
+    /// second OPEN.
+    func createFile(path: String, permissions: Int = 0o644, keepOpen: Bool = false) throws {
         guard let sftp = sftpSession else { throw MountError.sftpError("No session") }
 
-        let handle = libssh2_sftp_open_ex(
-            sftp, path, UInt32(path.utf8.count),
-            UInt(LIBSSH2_FXF_CREAT | LIBSSH2_FXF_TRUNC | LIBSSH2_FXF_WRITE),
-            Int(permissions),
-            LIBSSH2_SFTP_OPENFILE
-        )
-        guard handle != nil else { throw sftpError("create failed for \(path)") }
-        ssh2_sftp_close(handle)
+        var flags = UInt(LIBSSH2_FXF_CREAT | LIBSSH2_FXF_TRUNC | LIBSSH2_FXF_WRITE)
+        if keepOpen {
+            flags |= UInt(LIBSSH2_FXF_READ)
+            reportOpening(path)
+        }
+        defer { if keepOpen { reportHandle(path) } }
+        let handle: OpaquePointer
+        while true {
+            if let opened = libssh2_sftp_open_ex(
+                sftp, path, UInt32(path.utf8.count),
+                flags,
+                Int(permissions),
+                LIBSSH2_SFTP_OPENFILE
+            ) {
+                handle = opened
+                break
+            }
+            guard shouldRetryEAGAIN() else { throw sftpError("create failed for \(path)") }
+            try waitSocketReady()
+        }
+        guard keepOpen else {
+            closeFileHandle(handle)
+            return
+        }
+
+        // A handle cached for an earlier file at this path would write to the
+        // old one. Closed without reporting, so the path stays registered.
+        suspendedHandles.removeValue(forKey: path)
+        if let stale = handleCache.removeValue(forKey: path) {
+            closeFileHandle(stale.handle)
+        }
+        if handleCache.count >= Self.maxCachedHandles {
+            evictLRUHandle()
+        }
+        handleCache[path] = CachedHandle(handle: handle, forWriting: true, dirty: false, lastUsed: Date())
     }
 
     func remove(path: String) throws {
@@ -812,15 +1089,39 @@ final class SFTPSession: @unchecked Sendable {
     // MARK: - Metadata
 
     func stat(path: String) throws -> SFTPFileAttributes {
+        try stat(path: path, type: LIBSSH2_SFTP_STAT, name: "stat")
+    }
+
+    /// Like `stat`, but describes a symlink itself rather than its target.
+    func lstat(path: String) throws -> SFTPFileAttributes {
+        try stat(path: path, type: LIBSSH2_SFTP_LSTAT, name: "lstat")
+    }
+
+    private func stat(path: String, type: Int32, name: String) throws -> SFTPFileAttributes {
         guard let sftp = sftpSession else { throw MountError.sftpError("No session") }
 
         var attrs = LIBSSH2_SFTP_ATTRIBUTES()
         let rc = libssh2_sftp_stat_ex(
             sftp, path, UInt32(path.utf8.count),
-            LIBSSH2_SFTP_STAT, &attrs
+            type, &attrs
         )
-        guard rc == 0 else { throw sftpError("stat failed for \(path)") }
+        guard rc == 0 else { throw sftpError("\(name) failed for \(path)") }
+        return Self.fileAttributes(from: attrs)
+    }
 
+    /// Like `stat`, but through this session's cached handle for the path when
+    /// there is one, e.g. the handle kept by `createFile(keepOpen:)`.
+    func fstat(path: String) throws -> SFTPFileAttributes {
+        guard var entry = handleCache[path] else { return try stat(path: path) }
+        var attrs = LIBSSH2_SFTP_ATTRIBUTES()
+        let rc = try withEAGAINRetry { ssh2_sftp_fstat(entry.handle, &attrs) }
+        guard rc == 0 else { throw sftpError("fstat failed for \(path)") }
+        entry.lastUsed = Date()
+        handleCache[path] = entry
+        return Self.fileAttributes(from: attrs)
+    }
+
+    private static func fileAttributes(from attrs: LIBSSH2_SFTP_ATTRIBUTES) -> SFTPFileAttributes {
         let mode = attrs.permissions
         let isDir = (mode & UInt(LIBSSH2_SFTP_S_IFDIR)) != 0
         let isSymlink = (mode & UInt(LIBSSH2_SFTP_S_IFLNK)) == UInt(LIBSSH2_SFTP_S_IFLNK)
@@ -836,8 +1137,20 @@ final class SFTPSession: @unchecked Sendable {
         )
     }
 
+    /// Set attributes by path, or through this session's open write handle for
+    /// the path if there is one, which spares the server a path lookup.
+    /// Read-only handles are not used: servers cannot truncate through them.
     func setstat(path: String, attrs: inout LIBSSH2_SFTP_ATTRIBUTES) throws {
         guard let sftp = sftpSession else { throw MountError.sftpError("No session") }
+        if var entry = handleCache[path], entry.forWriting {
+            let rc = try withEAGAINRetry { ssh2_sftp_fsetstat(entry.handle, &attrs) }
+            if rc == 0 {
+                entry.lastUsed = Date()
+                handleCache[path] = entry
+                return
+            }
+            Log.sftp.debug("fsetstat failed for \(path, privacy: .public), falling back to setstat")
+        }
         let rc = libssh2_sftp_stat_ex(
             sftp, path, UInt32(path.utf8.count),
             LIBSSH2_SFTP_SETSTAT, &attrs
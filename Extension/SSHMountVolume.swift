@@ -26,6 +26,14 @@ final class SSHMountVolume: FSVolume,
 
     private static let defaultBlockSize = 4096
     private static let defaultIOSize = 262_144
+    /// How long read-only handles stay open after close, at most `cache_attr_s`.
+    private static let handleLinger: TimeInterval = 5
+    /// Largest listing the git profile re-reads to answer a single stat.
+    /// OpenSSH's sftp-server returns at most 100 names per READDIR reply, so
+    /// this bounds the relist at about 41 requests, which `git status` earns
+    /// back once it stats that many siblings. Bigger directories are mostly
+    /// build output that git ignores and stats sparsely.
+    private static let maxBatchedStatListing = 4096
     private static func pendingOperationLimit(for profile: MountProfile) -> Int {
         profile == .git ? 64 : 128
     }
@@ -40,29 +48,134 @@ final class SSHMountVolume: FSVolume,
     private let sftpQueue = DispatchQueue(label: "com.sshmount.sftp-serial", qos: .utility)
 
     /// Dispatch work onto the serial SFTP queue without introducing additional Sendable constraints.
-    private func enqueueSFTPOperation(onTimeout: (() -> Void)? = nil, _ work: @escaping () -> Void) {
-        enqueueOperation(on: sftpQueue, onTimeout: onTimeout, work)
+    private func enqueueSFTPOperation(
+        _ operationClass: OperationClass = .metadata,
+        onError: @escaping (Error) -> Void,
+        _ work: @escaping () throws -> Void
+    ) {
+        enqueueOperation(on: sftpQueue, operationClass, onError: onError) { _ in try work() }
     }
 
-    /// Global queue backpressure so overload does not create an unbounded async backlog.
-    private let pendingOperationSemaphore: DispatchSemaphore
+    /// Per-class admission budgets so overload does not create an unbounded async backlog
+    /// and bulk data cannot crowd out interactive metadata.
+    private let scheduler: OperationScheduler
+    private let metrics = VolumeMetrics()
 
-    private func enqueueOperation(on queue: DispatchQueue, onTimeout: (() -> Void)? = nil, _ work: @escaping () -> Void) {
-        let waitStart = Date()
-        let timeout = DispatchTime.now() + .milliseconds(mountOptions.queueTimeoutMs)
-        guard pendingOperationSemaphore.wait(timeout: timeout) == .success else {
-            healthMonitor.recordQueueWait(milliseconds: Double(mountOptions.queueTimeoutMs), saturated: true)
-            healthMonitor.triggerReconnect(reason: .workerExhausted)
-            onTimeout?()
-            return
+    /// Primary-session operations waiting for the connection to come back.
+    private let reconnectWaitList = ReconnectWaitList()
+
+    /// Thrown by `withPrimaryReconnect` when the primary session is down; the
+    /// enqueue wrapper parks the operation instead of blocking `sftpQueue`.
+    private struct ReconnectPending: Error {}
+
+    /// Admit work onto `queue` without ever blocking the calling FSKit thread.
+    ///
+    /// Work that cannot be admitted immediately is parked by the scheduler and
+    /// fails with `EAGAIN` if it is still parked after `queue_timeout_ms`.
+    /// Every operation also carries an `op_timeout_s` deadline from submission;
+    /// work that reaches the front of its queue after that is dropped without
+    /// touching libssh2.
+    ///
+    /// Work submitted while its session is reconnecting is held in that
+    /// session's reconnect wait list without a scheduler slot, and resumed in
+    /// order once the session is back. Work that hits a connection error is
+    /// parked the same way and retried once. Either way it fails with
+    /// `ETIMEDOUT` if its deadline passes first. Errors thrown by `work`, and
+    /// all of the failures above, are reported through `onError`.
+    ///
+    /// `speculative` work, such as read-ahead, runs only if a slot is free
+    /// right away and its session is up; otherwise it fails with `EAGAIN`
+    /// instead of waiting in front of requests someone is blocked on.
+    private func enqueueOperation(
+        on queue: DispatchQueue,
+        _ operationClass: OperationClass,
+        flow: String = "",
+        cost: Int = 0,
+        speculative: Bool = false,
+        onError: @escaping (Error) -> Void,
+        _ work: @escaping (_ token: SFTPCancellationToken) throws -> Void
+    ) {
+        let queueTimeoutMs = mountOptions.queueTimeoutMs
+        let operationDeadline = DispatchTime.now() + .milliseconds(Int(mountOptions.operationTimeout * 1000))
+        let token = SFTPCancellationToken(deadline: operationDeadline)
+        let scheduler = self.scheduler
+        let metrics = self.metrics
+        let healthMonitor = self.healthMonitor
+        let waitList = allWorkers.first { $0.queue === queue }?.reconnectWaitList ?? reconnectWaitList
+
+        func expireParked() {
+            metrics.recordExpiredWhileParked(operationClass)
+            onError(POSIXError(.ETIMEDOUT))
         }
-        let waitedMs = Date().timeIntervalSince(waitStart) * 1000
-        healthMonitor.recordQueueWait(milliseconds: waitedMs, saturated: false)
-        let semaphore = pendingOperationSemaphore
-        queue.async(execute: DispatchWorkItem(block: {
-            defer { semaphore.signal() }
-            work()
-        }))
+
+        func submit(isRetry: Bool) {
+            if speculative, waitList.isHolding {
+                onError(POSIXError(.EAGAIN))
+                return
+            }
+            if waitList.parkIfHolding(
+                   deadline: operationDeadline,
+                   resume: { submit(isRetry: isRetry) },
+                   expire: expireParked
+               ) {
+                return
+            }
+
+            let waitStart = Date()
+            scheduler.submit(
+                operationClass,
+                flow: flow,
+                cost: cost,
+                parks: !speculative,
+                deadline: .now() + .milliseconds(queueTimeoutMs),
+                onAdmit: {
+                    let waitedMs = Date().timeIntervalSince(waitStart) * 1000
+                    metrics.recordQueueWait(operationClass, milliseconds: waitedMs)
+                    healthMonitor.recordQueueWait(milliseconds: waitedMs, saturated: false)
+                    queue.async(execute: DispatchWorkItem(block: {
+                        defer { scheduler.release(operationClass) }
+                        if token.isCancelled {
+                            metrics.recordExpiredBeforeStart(operationClass)
+                            onError(POSIXError(.EAGAIN))
+                            return
+                        }
+                        do {
+                            try work(token)
+                        } catch is ReconnectPending where speculative {
+                            onError(POSIXError(.EAGAIN))
+                        } catch is ReconnectPending where !isRetry {
+                            // The session cannot reconnect until this block returns,
+                            // so the wait list is always released after this park.
+                            waitList.park(
+                                deadline: operationDeadline,
+                                resume: { submit(isRetry: true) },
+                                expire: expireParked
+                            )
+                        } catch is ReconnectPending {
+                            Log.volume.error("Session still unavailable after reconnect")
+                            onError(POSIXError(.ETIMEDOUT))
+                        } catch {
+                            onError(error)
+                        }
+                    }))
+                },
+                onReject: { rejection in
+                    metrics.recordAdmissionRejected(operationClass, rejection)
+                    switch rejection {
+                    case .deadlineExpired:
+                        healthMonitor.recordQueueWait(milliseconds: Double(queueTimeoutMs), saturated: true)
+                        healthMonitor.triggerReconnect(reason: .workerExhausted)
+                    case .overloaded:
+                        Log.volume.notice("Admission queue full, rejecting \(operationClass.description, privacy: .public) operation")
+                    case .busy:
+                        break
+                    }
+                    onError(POSIXError(.EAGAIN))
+                }
+            )
+        }
+
+        submit(isRetry: false)
     }
 
     /// Dedicated SSH session and serial queue for keepalive probes.
@@ -74,6 +187,10 @@ final class SSHMountVolume: FSVolume,
     private final class IOWorker: @unchecked Sendable {
         let sftp: SFTPSession
         let queue: DispatchQueue
+        let readLatency = ReadLatencyTracker()
+        let pendingReleases = PendingBatch<String>()
+        /// Operations parked while this session reconnects.
+        let reconnectWaitList = ReconnectWaitList()
 
         init(sftp: SFTPSession, label: String) {
             self.sftp = sftp
@@ -81,10 +198,70 @@ final class SSHMountVolume: FSVolume,
         }
     }
 
+    /// Requests collected until a single block handles all of them, e.g. handle
+    /// releases for a burst of closes or removals.
+    private final class PendingBatch<Element>: @unchecked Sendable {
+        private let lock = NSLock()
+        private var elements: [Element] = []
+
+        /// Queue `element`. Returns true if the caller must schedule a drain.
+        func add(_ element: Element) -> Bool {
+            lock.lock()
+            defer { lock.unlock() }
+            elements.append(element)
+            return elements.count == 1
+        }
+
+        func take() -> [Element] {
+            lock.lock()
+            defer { lock.unlock() }
+            let taken = elements
+            elements.removeAll()
+            return taken
+        }
+    }
+
+    /// A close waiting for the next close-time fsync batch.
+    private struct PendingClose {
+        let path: String
+        let reply: (Error?) -> Void
+    }
+
+    /// Close-time fsync failures of one batch, recorded from several session queues.
+    private final class CloseFailures: @unchecked Sendable {
+        private let lock = NSLock()
+        private var errors: [String: Error] = [:]
+
+        func record(_ error: Error, forPath path: String) {
+            lock.lock()
+            defer { lock.unlock() }
+            if errors[path] == nil {
+                errors[path] = error
+            }
+        }
+
+        func error(forPath path: String) -> Error? {
+            lock.lock()
+            defer { lock.unlock() }
+            return errors[path]
+        }
+    }
+
+    /// Handle releases queued for the primary session.
+    private let primaryReleases = PendingBatch<String>()
+    /// Git profile closes waiting for the next fsync batch.
+    private let pendingCloses = PendingBatch<PendingClose>()
+    /// Which sessions hold a handle for each path.
+    private let handleRegistry: HandleRegistry
     private let readWorkers: [IOWorker]
     private let writeWorkers: [IOWorker]
     private let readWorkerLock = NSLock()
     private var nextReadWorkerIndex = 0
+    private let readAheadLock = NSLock()
+    /// Files with a read-ahead window in flight.
+    private var readAheadPaths: Set<String> = []
+    /// Set when `read_hedge_pct` is enabled and at least two read workers are connected.
+    private let hedgeBudget: HedgeBudget?
     private let shutdownLock = NSLock()
     private var isShutdown = false
 
@@ -94,7 +271,32 @@ final class SSHMountVolume: FSVolume,
 
     // MARK: - Attribute & Directory Cache
 
-    private let cache = AttributeCache()
+    private let cache: AttributeCache
+    private let createdOwnerLock = NSLock()
+    /// Owner the server gives items this volume creates, learned from the first one statted.
+    private var createdOwner: (uid: UInt32, gid: UInt32)?
+
+    /// In-flight metadata requests, so concurrent callers for the same path
+    /// share one round trip.
+    private let statFlights = SingleFlight<String, SFTPFileAttributes>()
+    private let readDirFlights = SingleFlight<String, [SFTPDirectoryEntry]>()
+    private let readlinkFlights = SingleFlight<String, String>()
+
+    /// Read-only handles kept open after close for a quick reopen.
+    private let lingeringHandles = LingeringHandles()
+
+    /// Directories to list ahead of `git status` (git profile).
+    private let indexPrefetch = IndexPrefetch()
+
+    /// Content-addressed files (`immutable_paths`), cached until changed locally.
+    private let immutablePatterns: [PathGlob]
+    /// Per-subtree cache settings (`cache_rules`).
+    private let cachePolicies: CachePolicies
+    /// Data of immutable files and of files under `content=on` rules.
+    private let contentCache = ContentCache(blockSize: SSHMountVolume.defaultIOSize)
+
+    /// Writes acknowledged while reconnecting, replayed once connected (`write_journal_mb`).
+    private let writeJournal: WriteJournal?
 
     init(
         volumeID: FSVolume.Identifier,
@@ -115,18 +317,51 @@ final class SSHMountVolume: FSVolume,
         self.writeWorkers = writeSessions.enumerated().map {
             IOWorker(sftp: $0.element, label: "com.sshmount.sftp-write-\($0.offset)")
         }
+        let handleRegistry = HandleRegistry()
+        for session in [sftp] + readSessions + writeSessions {
+            session.handleRegistry = handleRegistry
+        }
+        self.handleRegistry = handleRegistry
         self.remotePath = remotePath
         self.mountOptions = options
-        self.pendingOperationSemaphore = DispatchSemaphore(
-            value: Self.pendingOperationLimit(for: options.profile)
+        self.scheduler = OperationScheduler(
+            budgets: .init(total: Self.pendingOperationLimit(for: options.profile)),
+            quantum: Self.defaultIOSize
         )
         self.allWorkers = readWorkers + writeWorkers
+        self.hedgeBudget = options.readHedgePercent > 0 && readWorkers.count > 1
+            ? HedgeBudget(percent: options.readHedgePercent)
+            : nil
+        // Expired entries are only read back within the grace window, or for
+        // as long as degraded mode or the git profile's batched stats may need them.
+        self.cache = AttributeCache(
+            staleRetention: options.degradedMode == .stale || options.profile == .git
+                ? nil
+                : .seconds(options.cacheGraceTimeout)
+        )
+        self.immutablePatterns = options.immutablePaths.compactMap(PathGlob.init)
+        self.cachePolicies = CachePolicies(options: options)
+        self.writeJournal = options.writeJournalMB > 0
+            ? WriteJournal(
+                directory: FileManager.default.temporaryDirectory
+                    .appendingPathComponent("sshmount-journal-\(UUID().uuidString)"),
+                capacityBytes: options.writeJournalMB * 1024 * 1024
+            )
+            : nil
         self.healthMonitor = healthMonitor
         super.init(volumeID: volumeID, volumeName: volumeName)
         setupHealthMonitor()
     }
 
     private func setupHealthMonitor() {
+        healthMonitor.onSnapshot = { [weak self] in
+            guard let self else { return }
+            self.closeExpiredLingeringHandles()
+            let counts = self.cache.takeEvictionCounts()
+            self.metrics.recordCacheEvictions(evicted: counts.evicted, swept: counts.swept)
+            self.metrics.emitSnapshot()
+        }
+
         // Keepalive probes run on a dedicated session + queue, never blocked by I/O.
         healthMonitor.onSendSSHKeepalive = { [weak self] timeoutMs in
             guard let self else { return false }
@@ -159,7 +394,6 @@ final class SSHMountVolume: FSVolume,
             // Then reconnect the primary session.
             return self.sftpQueue.sync {
                 do {
-                    self.sftp.releaseAllHandles()
                     try self.sftp.reconnect()
                     return true
                 } catch {
@@ -171,10 +405,21 @@ final class SSHMountVolume: FSVolume,
 
         healthMonitor.onStateChanged = { [weak self] newState in
             guard let self else { return }
-            if newState == .connected {
-                // Caches are stale after reconnection
-                self.invalidateAllCaches()
+            switch newState {
+            case .reconnecting:
+                self.reconnectWaitList.hold()
+            case .connected:
+                // Caches may be stale after reconnection
+                self.markCachesForRevalidation()
                 self.reconnectIOSessions()
+                self.replayWriteJournal()
+                let parked = self.reconnectWaitList.count
+                if parked > 0 {
+                    Log.volume.notice("Resuming \(parked, privacy: .public) operations parked during reconnect")
+                }
+                self.reconnectWaitList.releaseAll()
+            case .suspect:
+                break
             }
         }
     }
@@ -201,46 +446,74 @@ final class SSHMountVolume: FSVolume,
 
     /// Dispatch reads to worker sessions in round-robin order.
     /// Falls back to the primary session if no worker sessions are configured.
-    private func enqueueReadOperation(onTimeout: (() -> Void)? = nil, _ work: @escaping (_ session: SFTPSession) -> Void) {
-        guard !readWorkers.isEmpty else {
-            enqueueSFTPOperation(onTimeout: onTimeout) { work(self.sftp) }
+    private func enqueueReadOperation(
+        path: String,
+        length: Int,
+        speculative: Bool = false,
+        onError: @escaping (Error) -> Void,
+        _ work: @escaping (_ session: SFTPSession, _ token: SFTPCancellationToken) throws -> Void
+    ) {
+        // Reads of a file with journaled writes queue behind the replay on the
+        // primary session so they see the acknowledged data.
+        guard !readWorkers.isEmpty, !hasJournaledWrites(path) else {
+            enqueueOperation(on: sftpQueue, .read, flow: path, cost: length, speculative: speculative, onError: onError) {
+                try work(self.sftp, $0)
+            }
             return
         }
 
+        enqueueReadOperation(on: nextReadWorker(), path: path, length: length, speculative: speculative, onError: onError, work)
+    }
+
+    private func enqueueReadOperation(
+        on worker: IOWorker,
+        path: String,
+        length: Int,
+        speculative: Bool = false,
+        onError: @escaping (Error) -> Void,
+        _ work: @escaping (_ session: SFTPSession, _ token: SFTPCancellationToken) throws -> Void
+    ) {
+        enqueueOperation(on: worker.queue, .read, flow: path, cost: length, speculative: speculative, onError: onError, {
+            try work(worker.sftp, $0)
+        })
+    }
+
+    private func nextReadWorker() -> IOWorker {
         readWorkerLock.lock()
+        defer { readWorkerLock.unlock() }
         let index = nextReadWorkerIndex % readWorkers.count
         nextReadWorkerIndex += 1
-        let worker = readWorkers[index]
-        readWorkerLock.unlock()
-
-        enqueueOperation(on: worker.queue, onTimeout: onTimeout, {
-            work(worker.sftp)
-        })
+        return readWorkers[index]
     }
 
-    private func enqueueWriteOperation(path: String, onTimeout: (() -> Void)? = nil, _ work: @escaping (_ session: SFTPSession) -> Void) {
-        guard !writeWorkers.isEmpty else {
-            enqueueSFTPOperation(onTimeout: onTimeout) { work(self.sftp) }
+    private func enqueueWriteOperation(
+        path: String,
+        length: Int,
+        onError: @escaping (Error) -> Void,
+        _ work: @escaping (_ session: SFTPSession, _ token: SFTPCancellationToken) throws -> Void
+    ) {
+        guard let worker = writeWorker(for: path) else {
+            enqueueOperation(on: sftpQueue, .write, flow: path, cost: length, onError: onError) { try work(self.sftp, $0) }
             return
         }
 
-        let worker: IOWorker
-        if writeWorkers.count == 1 {
-            worker = writeWorkers[0]
-        } else {
-            var hash: UInt64 = 1469598103934665603
-            for byte in path.utf8 {
-                hash ^= UInt64(byte)
-                hash &*= 1099511628211
-            }
-            worker = writeWorkers[Int(hash % UInt64(writeWorkers.count))]
-        }
-
-        enqueueOperation(on: worker.queue, onTimeout: onTimeout, {
-            work(worker.sftp)
+        enqueueOperation(on: worker.queue, .write, flow: path, cost: length, onError: onError, {
+            try work(worker.sftp, $0)
         })
     }
 
+    /// The write worker that owns `path`, so all writes to a file stay ordered
+    /// on one session. Nil if no write workers are configured.
+    private func writeWorker(for path: String) -> IOWorker? {
+        guard writeWorkers.count > 1 else { return writeWorkers.first }
+        var hash: UInt64 = 1469598103934665603
+        for byte in path.utf8 {
+            hash ^= UInt64(byte)
+            hash &*= 1099511628211
+        }
+        return writeWorkers[Int(hash % UInt64(writeWorkers.count))]
+    }
+
     private func withHealthTracked<T>(_ op: () throws -> T) throws -> T {
         healthMonitor.recordOperationStart()
         var success = false
@@ -250,21 +523,74 @@ final class SSHMountVolume: FSVolume,
         return value
     }
 
-    private func withWorkerReconnect<T>(_ session: SFTPSession, op: () throws -> T) throws -> T {
+    /// Run a worker-session operation, reconnecting the session once if the
+    /// transport dropped. If that fails, or a reconnect is already underway,
+    /// throws `ReconnectPending` so the enqueue wrapper parks the operation in
+    /// the worker's wait list; retries are scheduled on the worker's queue, so
+    /// nothing sleeps on it.
+    private func withWorkerReconnect<T>(
+        _ session: SFTPSession,
+        op: () throws -> T
+    ) throws -> T {
         try withHealthTracked {
+            let worker = allWorkers.first { $0.sftp === session }
+            if worker?.reconnectWaitList.isHolding == true {
+                throw ReconnectPending()
+            }
             do {
                 return try op()
             } catch {
                 guard SFTPSession.isConnectionError(error) else { throw error }
-                session.releaseAllHandles()
-                try session.reconnect()
+                do {
+                    try session.reconnect()
+                } catch let reconnectError {
+                    guard let worker else { throw reconnectError }
+                    Log.volume.notice("Worker reconnect failed, retrying in \(Self.workerReconnectBackoffMs, privacy: .public)ms: \(reconnectError.localizedDescription, privacy: .public)")
+                    worker.reconnectWaitList.hold()
+                    scheduleWorkerReconnect(worker, afterMs: Self.workerReconnectBackoffMs)
+                    throw ReconnectPending()
+                }
+                // Reads and writes carry their own offset, so the interrupted
+                // request is simply reissued on the reopened handle.
                 return try op()
             }
         }
     }
 
+    private static let workerReconnectBackoffMs = 250
+
+    /// Retry a worker reconnect after `afterMs`, doubling up to four seconds.
+    /// Runs on the worker's queue behind whatever is already there, so the
+    /// operations that parked themselves are in the wait list by then. Gives
+    /// up once nothing is parked; the next operation starts over.
+    private func scheduleWorkerReconnect(_ worker: IOWorker, afterMs: Int) {
+        worker.queue.asyncAfter(deadline: .now() + .milliseconds(afterMs)) { [weak self] in
+            guard let self, worker.reconnectWaitList.isHolding else { return }
+            do {
+                try worker.sftp.reconnect()
+            } catch {
+                guard worker.reconnectWaitList.count > 0 else {
+                    worker.reconnectWaitList.releaseAll()
+                    return
+                }
+                let nextMs = min(afterMs * 2, 4_000)
+                Log.volume.notice("Worker reconnect failed, retrying in \(nextMs, privacy: .public)ms: \(error.localizedDescription, privacy: .public)")
+                self.scheduleWorkerReconnect(worker, afterMs: nextMs)
+                return
+            }
+            let parked = worker.reconnectWaitList.count
+            if parked > 0 {
+                Log.volume.notice("Resuming \(parked, privacy: .public) operations parked during worker reconnect")
+            }
+            worker.reconnectWaitList.releaseAll()
+        }
+    }
+
     /// Dispatch to the appropriate reconnect strategy based on which session is being used.
-    private func withAutoReconnect<T>(_ session: SFTPSession, op: () throws -> T) throws -> T {
+    private func withAutoReconnect<T>(
+        _ session: SFTPSession,
+        op: () throws -> T
+    ) throws -> T {
         if session === self.sftp {
             return try withPrimaryReconnect(op)
         } else {
@@ -273,10 +599,6 @@ final class SSHMountVolume: FSVolume,
     }
 
     private let allWorkers: [IOWorker]
-    private var reconnectWaitTimeout: TimeInterval {
-        max(15, mountOptions.healthTimeout * Double(mountOptions.healthFailures + 1))
-    }
-
     private func forEachWorker(_ body: (IOWorker) -> Void) {
         for worker in allWorkers {
             body(worker)
@@ -299,9 +621,9 @@ final class SSHMountVolume: FSVolume,
     private func reconnectIOSessions() {
         forEachWorker { worker in
             worker.queue.async {
-                worker.sftp.releaseAllHandles()
                 do {
                     try worker.sftp.reconnect()
+                    worker.reconnectWaitList.releaseAll()
                 } catch {
                     Log.volume.notice("Worker reconnect failed: \(error.localizedDescription, privacy: .public)")
                 }
@@ -309,16 +631,171 @@ final class SSHMountVolume: FSVolume,
         }
     }
 
-    private func releaseHandleAcrossSessions(path: String) {
-        try? forEachSessionSync { session in
-            session.releaseHandle(path: path)
+    /// Sessions that hold a handle for `path`, with their queues.
+    private func sessionsHolding(_ path: String) -> [(session: SFTPSession, queue: DispatchQueue, releases: PendingBatch<String>)] {
+        let all = [(session: sftp, queue: sftpQueue, releases: primaryReleases)]
+            + allWorkers.map { (session: $0.sftp, queue: $0.queue, releases: $0.pendingReleases) }
+        return all.filter { handleRegistry.holds(path: path, session: $0.session) }
+    }
+
+    /// Drop cached handles for `path`: inline on `current`, whose queue the
+    /// caller runs on, and on any other session holding one without waiting
+    /// for its work in progress. Each session drains its queued releases in
+    /// one block, ahead of any work submitted to its queue afterwards.
+    private func releaseHandleAcrossSessions(path: String, on current: SFTPSession) {
+        current.releaseHandle(path: path)
+        for (session, queue, pending) in sessionsHolding(path) where session !== current {
+            guard pending.add(path) else { continue }
+            queue.async {
+                for path in pending.take() {
+                    session.releaseHandle(path: path)
+                }
+            }
         }
     }
 
-    private func syncPathAcrossSessions(path: String) throws {
-        try forEachSessionSync { session in
-            try session.syncHandle(path: path)
+    /// Release a closed file's handles, except read-only ones, which linger so
+    /// that reopening it shortly after skips OPEN. Lingering relies on cached
+    /// attributes to notice remote changes, so it is off without them and in
+    /// the git profile. Runs on `sftpQueue`.
+    private func closeHandlesAcrossSessions(path: String) {
+        let timeout = attrTimeout(for: path)
+        guard mountOptions.profile != .git,
+              timeout > 0,
+              !hasJournaledWrites(path),
+              let attrs = cache.cachedAttrs(forPath: path) else {
+            lingeringHandles.remove(path: path)
+            releaseHandleAcrossSessions(path: path, on: sftp)
+            return
+        }
+        let deadline = Date().addingTimeInterval(min(Self.handleLinger, timeout))
+        lingeringHandles.add(path: path, size: attrs.size, modifiedAt: attrs.modifiedAt, expiresAt: deadline)
+        for (session, queue, _) in sessionsHolding(path) {
+            if session === sftp {
+                session.lingerHandle(path: path, until: deadline)
+            } else {
+                queue.async {
+                    session.lingerHandle(path: path, until: deadline)
+                }
+            }
+        }
+    }
+
+    /// Drop lingering handles for `path` if a fresh stat shows the file changed
+    /// on the server, so the next open does not read the old file. Runs on
+    /// `sftpQueue`.
+    private func dropLingeringHandlesIfChanged(_ path: String, attrs: SFTPFileAttributes) {
+        guard lingeringHandles.hasChanged(path: path, attrs: attrs) else { return }
+        for (session, queue, _) in sessionsHolding(path) {
+            if session === sftp {
+                session.dropLingeringHandle(path: path)
+            } else {
+                queue.async {
+                    session.dropLingeringHandle(path: path)
+                }
+            }
+        }
+    }
+
+    private func closeExpiredLingeringHandles() {
+        sftpQueue.async {
+            self.sftp.closeExpiredLingeringHandles()
+        }
+        forEachWorker { worker in
+            worker.queue.async {
+                worker.sftp.closeExpiredLingeringHandles()
+            }
+        }
+    }
+
+    /// Fsync and release the handles of every close batched so far (git
+    /// profile). Each session holding handles fsyncs and closes all of its
+    /// paths in one block and the sessions run in parallel, so the round
+    /// trips of concurrent closes overlap instead of queueing one close at a
+    /// time. Each close is answered with its own result once every session
+    /// involved is done. Runs on `sftpQueue`.
+    private func commitPendingCloses() {
+        let closes = pendingCloses.take()
+        guard !closes.isEmpty else { return }
+
+        var batches: [ObjectIdentifier: (session: SFTPSession, queue: DispatchQueue, paths: [String])] = [:]
+        for path in Set(closes.map(\.path)) {
+            for holder in sessionsHolding(path) {
+                batches[ObjectIdentifier(holder.session), default: (session: holder.session, queue: holder.queue, paths: [])]
+                    .paths.append(path)
+            }
+            // Writes still queued on the path's worker land before its fsync.
+            if let worker = writeWorker(for: path), batches[ObjectIdentifier(worker.sftp)]?.paths.last != path {
+                batches[ObjectIdentifier(worker.sftp), default: (session: worker.sftp, queue: worker.queue, paths: [])]
+                    .paths.append(path)
+            }
+        }
+
+        let failures = CloseFailures()
+        let syncAndRelease = { (session: SFTPSession, paths: [String]) in
+            for path in paths {
+                do {
+                    try session.syncHandle(path: path)
+                } catch {
+                    failures.record(error, forPath: path)
+                }
+                session.releaseHandle(path: path)
+            }
+        }
+        let group = DispatchGroup()
+        for batch in batches.values where batch.session !== sftp {
+            group.enter()
+            batch.queue.async(execute: DispatchWorkItem(block: {
+                syncAndRelease(batch.session, batch.paths)
+                group.leave()
+            }))
+        }
+        if let primary = batches[ObjectIdentifier(sftp)] {
+            syncAndRelease(primary.session, primary.paths)
+        }
+
+        group.notify(queue: sftpQueue, work: DispatchWorkItem(block: {
+            for close in closes {
+                // Journaled writes have not reached the server yet; keep their sizes.
+                if !self.hasJournaledWrites(close.path) {
+                    self.cache.reconcileLocalWrites(forPath: close.path)
+                }
+                if let error = failures.error(forPath: close.path) {
+                    Log.volume.notice("closeItem failed for \(close.path, privacy: .public): \(error.localizedDescription, privacy: .public)")
+                    close.reply(POSIXError(Self.posixCode(from: error)))
+                } else {
+                    close.reply(nil)
+                }
+            }
+        }))
+    }
+
+    /// Fsync and release the handles worker sessions hold for `paths`, each
+    /// on its own queue, so a rename publishes only durable data (git
+    /// profile). Sessions holding no handle for a path are skipped, and
+    /// nothing waits on `sftpQueue`: `completion` runs there once every
+    /// holder is done, with the first failure. The primary session's handles
+    /// are left to the caller's operation on `sftpQueue`.
+    private func syncWorkerHandles(paths: [String], completion: @escaping (Error?) -> Void) {
+        let failures = CloseFailures()
+        let group = DispatchGroup()
+        for path in paths {
+            for holder in sessionsHolding(path) where holder.session !== sftp {
+                group.enter()
+                holder.queue.async(execute: DispatchWorkItem(block: {
+                    do {
+                        try holder.session.syncHandle(path: path)
+                    } catch {
+                        failures.record(error, forPath: path)
+                    }
+                    holder.session.releaseHandle(path: path)
+                    group.leave()
+                }))
+            }
         }
+        group.notify(queue: sftpQueue, work: DispatchWorkItem(block: {
+            completion(paths.lazy.compactMap { failures.error(forPath: $0) }.first)
+        }))
     }
 
     private func syncAllWriteHandlesAcrossSessions() throws {
@@ -345,6 +822,10 @@ final class SSHMountVolume: FSVolume,
             keepaliveSession.disconnect()
         }
         sftp.disconnect()
+
+        if let dropped = writeJournal?.discard(), dropped > 0 {
+            Log.volume.error("Discarded \(dropped, privacy: .public) journaled writes that were never replayed")
+        }
     }
 
     func shutdown() {
@@ -353,27 +834,24 @@ final class SSHMountVolume: FSVolume,
 
     // MARK: - Reconnect Wrapper
 
-    /// Flush all attribute and directory caches (called after reconnection).
-    private func invalidateAllCaches() {
-        cache.invalidateAll()
-        Log.volume.debug("All caches invalidated after reconnection")
+    /// Require revalidation of every cached entry after reconnection. Entries
+    /// keep their data and are checked by size and mtime on first use.
+    private func markCachesForRevalidation() {
+        cache.beginRevalidationEpoch()
+        Log.volume.debug("All caches marked for revalidation after reconnection")
     }
 
     /// Execute an SFTP operation with resilience to transient disconnections.
     ///
-    /// If the health monitor indicates the connection is suspended or reconnecting,
-    /// waits up to `reconnect_timeout` seconds for recovery before failing.
-    /// On connection error during the operation, triggers reconnection and retries once.
+    /// Never waits for the connection: if the health monitor reports it is
+    /// reconnecting, or the operation hits a connection error (which triggers a
+    /// reconnect), throws `ReconnectPending` so the enqueue wrapper can park the
+    /// operation until the session is back and retry it.
     private func withPrimaryReconnect<T>(_ op: () throws -> T) throws -> T {
         try withHealthTracked {
-            // If we know the connection is down, wait for reconnection first
             if healthMonitor.state == .reconnecting {
-                Log.volume.debug("withPrimaryReconnect: connection not ready (state=\(self.healthMonitor.state.description, privacy: .public)), waiting")
-                let recovered = healthMonitor.waitForConnected(timeout: reconnectWaitTimeout)
-                if !recovered {
-                    Log.volume.error("withPrimaryReconnect: timed out waiting for reconnection")
-                    throw POSIXError(.ETIMEDOUT)
-                }
+                Log.volume.debug("withPrimaryReconnect: connection not ready (state=\(self.healthMonitor.state.description, privacy: .public)), parking")
+                throw ReconnectPending()
             }
 
             do {
@@ -382,12 +860,7 @@ final class SSHMountVolume: FSVolume,
                 guard SFTPSession.isConnectionError(error) else { throw error }
                 Log.volume.notice("Connection error detected, triggering reconnect")
                 healthMonitor.triggerReconnect(reason: .transportError)
-                let recovered = healthMonitor.waitForConnected(timeout: reconnectWaitTimeout)
-                guard recovered else {
-                    Log.volume.error("withPrimaryReconnect: reconnect failed")
-                    throw POSIXError(.ETIMEDOUT)
-                }
-                return try op()
+                throw ReconnectPending()
             }
         }
     }
@@ -405,6 +878,13 @@ final class SSHMountVolume: FSVolume,
         return fallback
     }
 
+    /// Count transfers abandoned mid-flight because their deadline passed.
+    private func recordIfAborted(_ error: Error, _ operationClass: OperationClass) {
+        if let posixError = error as? POSIXError, posixError.code == .ECANCELED {
+            metrics.recordAbortedInFlight(operationClass)
+        }
+    }
+
     // MARK: - Attributes Helpers
 
     /// Convert SFTPFileAttributes → FSItem.Attributes.
@@ -427,6 +907,37 @@ final class SSHMountVolume: FSVolume,
         return attrs
     }
 
+    /// Convert SFTPFileAttributes for a path, resolving its item and parent IDs.
+    private func fsAttributes(from sftpAttrs: SFTPFileAttributes, forPath path: String) -> FSItem.Attributes {
+        let id = itemID(forPath: path)
+        let parentID = itemID(forPath: (path as NSString).deletingLastPathComponent)
+        return fsAttributes(from: sftpAttrs, itemID: id, parentID: parentID)
+    }
+
+    /// Attributes after a successful SETSTAT of `attrs` over `base`. The mtime
+    /// is only replaced when the request set it: a truncation also moves it on
+    /// the server, but to a time from the server's clock that only a stat can
+    /// tell, so the caller does not cache that result.
+    private static func applying(_ attrs: LIBSSH2_SFTP_ATTRIBUTES, to base: SFTPFileAttributes) -> SFTPFileAttributes {
+        let flags = attrs.flags
+        let size = flags & UInt(LIBSSH2_SFTP_ATTR_SIZE) != 0 ? attrs.filesize : base.size
+        let modifiedAt = flags & UInt(LIBSSH2_SFTP_ATTR_ACMODTIME) != 0
+            ? Date(timeIntervalSince1970: TimeInterval(attrs.mtime))
+            : base.modifiedAt
+        let hasOwner = flags & UInt(LIBSSH2_SFTP_ATTR_UIDGID) != 0
+        return SFTPFileAttributes(
+            size: size,
+            permissions: flags & UInt(LIBSSH2_SFTP_ATTR_PERMISSIONS) != 0
+                ? UInt32(attrs.permissions & 0o7777)
+                : base.permissions,
+            uid: hasOwner ? UInt32(attrs.uid) : base.uid,
+            gid: hasOwner ? UInt32(attrs.gid) : base.gid,
+            modifiedAt: modifiedAt,
+            isDirectory: base.isDirectory,
+            isSymlink: base.isSymlink
+        )
+    }
+
     /// Get item ID for a path (creates one if needed).
     private func itemID(forPath path: String) -> UInt64 {
         itemTracker.itemID(forPath: path)
@@ -435,136 +946,753 @@ final class SSHMountVolume: FSVolume,
     // MARK: - Cached SFTP Stat
 
     /// Stat with optional caching based on cache_timeout option.
+    ///
+    /// With `cache_grace_s`, an entry that expired within the grace window is
+    /// returned as is while a background stat refreshes it; only entries past
+    /// the window wait for the server.
     private func cachedStat(path: String) throws -> SFTPFileAttributes {
-        let timeout = mountOptions.cacheTimeout
+        let immutable = isImmutable(path)
+        if immutable, let attrs = contentCache.attrs(forPath: path) {
+            metrics.recordAttrCacheHit()
+            return attrs
+        }
+        let timeout = attrTimeout(for: path)
         if timeout > 0, let cached = cache.cachedAttrs(forPath: path) {
+            metrics.recordAttrCacheHit()
             return cached
         }
+        let grace = mountOptions.cacheGraceTimeout
+        if timeout > 0, grace > 0, let stale = cache.attrsWithinGrace(forPath: path, grace: grace) {
+            metrics.recordAttrCacheStaleHit()
+            refreshAttrsInBackground(path: path)
+            return stale
+        }
+        if timeout > 0, mountOptions.profile == .git, let attrs = try statThroughParentListing(path) {
+            if immutable { rememberImmutableAttrs(attrs, path: path) }
+            return attrs
+        }
+        let previous = timeout > 0 ? cache.attrsNeedingRevalidation(forPath: path) : nil
 
+        metrics.recordMetadataRoundTrip()
         let attrs = try withPrimaryReconnect {
             try sftp.stat(path: path)
         }
+        dropLingeringHandlesIfChanged(path, attrs: attrs)
+        if immutable { rememberImmutableAttrs(attrs, path: path) }
 
+        if let previous {
+            let unchanged = previous.size == attrs.size && previous.modifiedAt == attrs.modifiedAt
+            metrics.recordCacheRevalidation(unchanged: unchanged ? 1 : 0, changed: unchanged ? 0 : 1)
+        }
         if timeout > 0 {
-            cache.setAttrs(attrs, forPath: path, timeout: timeout)
+            return cache.setAttrs(attrs, forPath: path, timeout: timeout)
         }
 
         return attrs
     }
 
+    /// Answer a stat by re-listing the parent directory while an expired
+    /// listing of it is still cached: one READDIR refreshes the attributes of
+    /// every sibling, where `git status` would otherwise stat each file in
+    /// turn. Used by the git profile, whose short TTLs expire between runs.
+    /// - Returns: nil if the parent listing is unknown, still fresh or too
+    ///   large, or the path is not in it; the caller then stats as usual. A
+    ///   fresh listing predates the open that dropped the path's attributes,
+    ///   so close-to-open rules it out as an answer, and one STAT is cheaper
+    ///   than relisting.
+    private func statThroughParentListing(_ path: String) throws -> SFTPFileAttributes? {
+        let parent = (path as NSString).deletingLastPathComponent
+        guard parent != path,
+              cache.cachedDirEntries(forPath: parent) == nil,
+              let previous = cache.staleDirEntries(forPath: parent),
+              previous.count <= Self.maxBatchedStatListing else { return nil }
+
+        do {
+            try relistDirectory(parent)
+        } catch let error as ReconnectPending {
+            throw error
+        } catch {
+            return nil
+        }
+        return cache.cachedAttrs(forPath: path)
+    }
+
+    /// List a directory on the primary session and cache both the listing and
+    /// the attributes of its entries.
+    private func relistDirectory(_ path: String) throws {
+        metrics.recordMetadataRoundTrip()
+        let entries = try withPrimaryReconnect { try sftp.readDirectory(path: path) }
+        cache.setDirEntries(entries, forPath: path, timeout: dirTimeout(for: path))
+        cache.setChildAttrs(ofDirectory: path, entries: entries, timeout: attrTimeout(for:))
+    }
+
+    /// Re-stat a path on the primary session behind the current operation,
+    /// at most once at a time per path. Failures just leave the entry to expire.
+    private func refreshAttrsInBackground(path: String) {
+        guard cache.beginRefresh(forPath: path) else { return }
+        metrics.recordAttrCacheRefresh()
+        enqueueSFTPOperation(.metadata, onError: { error in
+            self.cache.endRefresh(forPath: path)
+            Log.volume.debug("Background stat failed for \(path, privacy: .public): \(error.localizedDescription, privacy: .public)")
+        }) {
+            defer { self.cache.endRefresh(forPath: path) }
+            self.metrics.recordMetadataRoundTrip()
+            let attrs = try self.withPrimaryReconnect {
+                try self.sftp.stat(path: path)
+            }
+            self.dropLingeringHandlesIfChanged(path, attrs: attrs)
+            self.cache.setAttrs(attrs, forPath: path, timeout: self.attrTimeout(for: path))
+        }
+    }
+
+    /// Account for a completed write locally instead of invalidating: the
+    /// cached size and mtime follow the write without a round trip, and are
+    /// reconciled with the server at close or fsync.
+    private func recordLocalWrite(_ path: String, end: UInt64) {
+        contentCache.remove(path: path)
+        let timeout = attrTimeout(for: path)
+        guard timeout > 0 else {
+            invalidateCache(path, includeParent: false)
+            return
+        }
+        cache.recordLocalWrite(forPath: path, end: end, timeout: timeout)
+    }
+
     /// Invalidate cache entry for a path (called after writes/creates/deletes).
+    /// Requests already in flight for it are no longer joined by new callers.
     private func invalidateCache(_ path: String, includeParent: Bool = true) {
-        guard mountOptions.cacheTimeout > 0 || mountOptions.dirCacheTimeout > 0 else { return }
+        contentCache.remove(path: path)
+        statFlights.forget(path)
+        readDirFlights.forget(path)
+        readlinkFlights.forget(path)
+        if includeParent {
+            let parent = (path as NSString).deletingLastPathComponent
+            statFlights.forget(parent)
+            readDirFlights.forget(parent)
+        }
+        guard cachePolicies.cachesMetadata else { return }
         cache.invalidate(path, includeParent: includeParent)
     }
 
-    /// Read directory with optional caching based on dir_cache_timeout.
-    private func cachedReadDir(path: String) throws -> [SFTPDirectoryEntry] {
-        let timeout = mountOptions.dirCacheTimeout
-        if timeout > 0, let cached = cache.cachedDirEntries(forPath: path) {
-            return cached
-        }
+    /// Drop everything cached below a directory that was renamed or replaced.
+    private func invalidateDescendants(of path: String) {
+        contentCache.remove(descendantsOf: path)
+        guard cachePolicies.cachesMetadata else { return }
+        cache.invalidate(descendantsOf: path)
+    }
 
-        let entries = try withPrimaryReconnect { try sftp.readDirectory(path: path) }
+    // MARK: - Listing Patches
 
-        if timeout > 0 {
-            cache.setDirEntries(entries, forPath: path, timeout: timeout)
+    /// Whether a path is a directory, from cached attributes or its parent's
+    /// cached listing, even if expired: an item's type does not change in place.
+    private func knownIsDirectory(_ path: String) -> Bool? {
+        if let attrs = cache.staleAttrs(forPath: path) {
+            return attrs.isDirectory
         }
-
-        return entries
+        let parent = (path as NSString).deletingLastPathComponent
+        let name = (path as NSString).lastPathComponent
+        return cache.staleDirEntries(forPath: parent)?.first { $0.name == name }?.isDirectory
     }
 
-    // MARK: - Volume Lifecycle
+    /// Reflect a local create of `path` in the caches: its attributes are
+    /// cached and its parent's listing gains the entry instead of being dropped.
+    /// Without attributes the parent listing is invalidated as before.
+    private func recordCreated(_ path: String, attrs: SFTPFileAttributes?) {
+        invalidateCache(path, includeParent: false)
+        let parent = (path as NSString).deletingLastPathComponent
+        guard let attrs else {
+            invalidateCache(parent, includeParent: false)
+            return
+        }
+        let timeout = attrTimeout(for: path)
+        if timeout > 0, !attrs.isSymlink {
+            cache.setAttrs(attrs, forPath: path, timeout: timeout)
+        }
+        let entry = SFTPDirectoryEntry(
+            name: (path as NSString).lastPathComponent,
+            isDirectory: attrs.isDirectory,
+            isSymlink: attrs.isSymlink,
+            size: attrs.size,
+            permissions: attrs.permissions,
+            uid: attrs.uid,
+            gid: attrs.gid,
+            modifiedAt: attrs.modifiedAt
+        )
+        patchParentListing(parent, name: entry.name, with: entry)
+    }
 
-    func mount(
-        options: FSTaskOptions,
-        replyHandler reply: @escaping (Error?) -> Void
-    ) {
-        reply(nil)
+    /// Reflect a local remove of `path`: its entries are dropped and its
+    /// parent's listing loses the entry instead of being dropped.
+    private func recordRemoved(_ path: String) {
+        invalidateCache(path, includeParent: false)
+        let parent = (path as NSString).deletingLastPathComponent
+        patchParentListing(parent, name: (path as NSString).lastPathComponent, with: nil)
     }
 
-    func unmount(replyHandler reply: @escaping () -> Void) {
-        disconnectAllSessions()
-        reply()
+    /// The parent's mtime changed, so its attributes and any request in flight
+    /// for it are dropped; its listing is patched in place.
+    private func patchParentListing(_ parent: String, name: String, with entry: SFTPDirectoryEntry?) {
+        statFlights.forget(parent)
+        readDirFlights.forget(parent)
+        guard cachePolicies.cachesMetadata else { return }
+        cache.invalidateAttrs(parent)
+        cache.patchDirEntries(inDirectory: parent, name: name, with: entry)
     }
 
-    func synchronize(
-        flags: FSSyncFlags,
-        replyHandler reply: @escaping (Error?) -> Void
-    ) {
-        enqueueSFTPOperation(onTimeout: {
-            reply(POSIXError(.EAGAIN))
-        }) {
-            do {
-                try self.syncAllWriteHandlesAcrossSessions()
-                reply(nil)
-            } catch {
-                Log.volume.notice("synchronize failed: \(error.localizedDescription, privacy: .public)")
-                reply(POSIXError(Self.posixCode(from: error)))
-            }
+    /// Attributes of an item this volume just created, for patching listings,
+    /// built from the request: the requested mode, the current time and the
+    /// owner earlier creates were given. Until that owner is known the item is
+    /// statted once. Skipped when nothing is cached; a failed stat falls back
+    /// to invalidation.
+    private func createdItemAttrs(
+        _ path: String,
+        permissions: Int,
+        size: UInt64 = 0,
+        isDirectory: Bool = false,
+        isSymlink: Bool = false
+    ) -> SFTPFileAttributes? {
+        guard cachePolicies.cachesMetadata else { return nil }
+        guard let owner = knownCreatedOwner() else {
+            return learnCreatedOwner { try self.withPrimaryReconnect { try self.sftp.lstat(path: path) } }
         }
+        return SFTPFileAttributes(
+            size: size,
+            permissions: UInt32(permissions & 0o7777),
+            uid: owner.uid,
+            gid: owner.gid,
+            modifiedAt: Date(timeIntervalSince1970: Date().timeIntervalSince1970.rounded(.down)),
+            isDirectory: isDirectory,
+            isSymlink: isSymlink
+        )
     }
 
-    // MARK: - Activate / Deactivate
+    /// Attributes of an item this volume just renamed whose source had none cached.
+    private func movedItemAttrs(_ path: String) -> SFTPFileAttributes? {
+        guard cachePolicies.cachesMetadata else { return nil }
+        metrics.recordMetadataRoundTrip()
+        return try? withPrimaryReconnect { try sftp.lstat(path: path) }
+    }
 
-    func activate(
-        options: FSTaskOptions,
-        replyHandler reply: @escaping (FSItem?, Error?) -> Void
-    ) {
-        // Register the root item
-        let (rootItem, _) = item(forPath: remotePath)
-        reply(rootItem, nil)
+    private func knownCreatedOwner() -> (uid: UInt32, gid: UInt32)? {
+        createdOwnerLock.lock()
+        defer { createdOwnerLock.unlock() }
+        return createdOwner
     }
 
-    func deactivate(
-        options: FSDeactivateOptions,
-        replyHandler reply: @escaping (Error?) -> Void
-    ) {
-        disconnectAllSessions()
-        reply(nil)
+    /// Stat a created item and remember its owner for later creates.
+    private func learnCreatedOwner(_ stat: () throws -> SFTPFileAttributes) -> SFTPFileAttributes? {
+        metrics.recordMetadataRoundTrip()
+        guard let attrs = try? stat() else { return nil }
+        createdOwnerLock.lock()
+        createdOwner = (attrs.uid, attrs.gid)
+        createdOwnerLock.unlock()
+        return attrs
     }
 
-    // MARK: - Lookup
+    /// Attributes of an empty file just created on `session`, built like
+    /// `createdItemAttrs`. The first create is read through the handle
+    /// `createFile(keepOpen:)` left open there.
+    private func createdFileAttrs(_ path: String, permissions: Int, on session: SFTPSession) -> SFTPFileAttributes? {
+        guard cachePolicies.cachesMetadata else { return nil }
+        guard knownCreatedOwner() != nil else {
+            return learnCreatedOwner { try self.withAutoReconnect(session) { try session.fstat(path: path) } }
+        }
+        return createdItemAttrs(path, permissions: permissions)
+    }
 
-    func lookupItem(
-        named name: FSFileName,
-        inDirectory directory: FSItem,
-        replyHandler reply: @escaping (FSItem?, FSFileName?, Error?) -> Void
+    /// Run a metadata request on the primary session once for all concurrent
+    /// callers with the same path; late joiners receive the leader's result.
+    private func coalescedMetadata<Value>(
+        _ flights: SingleFlight<String, Value>,
+        path: String,
+        fetch: @escaping () throws -> Value,
+        completion: @escaping (Result<Value, Error>) -> Void
     ) {
-        guard let childName = name.string else {
-            reply(nil, nil, POSIXError(.ENOENT))
+        guard let ticket = flights.join(path, completion) else {
+            metrics.recordCoalescedRequest()
             return
         }
-        guard let fullPath = childPath(directory: directory, name: childName) else {
-            reply(nil, nil, POSIXError(.ENOENT))
-            return
+        enqueueSFTPOperation(onError: { error in
+            flights.complete(ticket, with: .failure(error))
+        }) {
+            let value = try fetch()
+            flights.complete(ticket, with: .success(value))
         }
+    }
 
-        enqueueSFTPOperation(onTimeout: {
-            reply(nil, nil, POSIXError(.EAGAIN))
-        }) {
-            do {
-                let _ = try self.cachedStat(path: fullPath)
-                let (childItem, _) = self.item(forPath: fullPath)
-                reply(childItem, name, nil)
-            } catch {
-                Log.volume.notice("lookupItem failed for \(fullPath, privacy: .public): \(error.localizedDescription, privacy: .public)")
-                reply(nil, nil, POSIXError(Self.posixCode(from: error, fallback: .ENOENT)))
+    /// Read directory with optional caching based on dir_cache_timeout, or
+    /// the `dir` TTL of the cache rule matching it.
+    ///
+    /// A listing cached before a reconnect is kept if the directory's mtime is
+    /// unchanged, which costs one stat instead of a full listing. A current
+    /// listing also revalidates the cached attributes of its children.
+    private func cachedReadDir(path: String) throws -> [SFTPDirectoryEntry] {
+        let timeout = dirTimeout(for: path)
+        guard timeout > 0 else {
+            metrics.recordMetadataRoundTrip()
+            return try withPrimaryReconnect { try sftp.readDirectory(path: path) }
+        }
+        if let cached = cache.cachedDirEntries(forPath: path) {
+            return cached
+        }
+
+        // The mtime is taken before listing, so a change that races the listing
+        // shows up as a newer mtime on the next revalidation. Only a listing
+        // kept across a reconnect is worth a stat; otherwise the mtime comes
+        // from whatever is already cached, if anything.
+        let directoryModifiedAt: Date?
+        if let previous = cache.dirEntriesNeedingRevalidation(forPath: path) {
+            let modifiedAt = try cachedStat(path: path).modifiedAt
+            if previous.directoryModifiedAt == modifiedAt {
+                cache.markDirEntriesRevalidated(forPath: path)
+                let children = cache.revalidateChildren(ofDirectory: path, entries: previous.entries)
+                metrics.recordCacheRevalidation(unchanged: 1 + children, changed: 0)
+                return previous.entries
             }
+            directoryModifiedAt = modifiedAt
+        } else {
+            directoryModifiedAt = cachedModifiedAt(ofDirectory: path)
         }
+
+        metrics.recordMetadataRoundTrip()
+        let entries = try withPrimaryReconnect { try sftp.readDirectory(path: path) }
+
+        cache.setDirEntries(entries, forPath: path, timeout: timeout, directoryModifiedAt: directoryModifiedAt)
+        let children = cache.revalidateChildren(ofDirectory: path, entries: entries)
+        if children > 0 {
+            metrics.recordCacheRevalidation(unchanged: children, changed: 0)
+        }
+        // The listing carries each child's attributes; later stats of them are local.
+        if cachePolicies.cachesMetadata {
+            cache.setChildAttrs(ofDirectory: path, entries: entries, timeout: attrTimeout(for:))
+        }
+
+        return entries
     }
 
-    func reclaimItem(
-        _ item: FSItem,
-        replyHandler reply: @escaping (Error?) -> Void
-    ) {
-        untrack(item)
-        reply(nil)
+    /// A directory's mtime from its cached attributes or its parent's cached
+    /// listing, without a round trip.
+    private func cachedModifiedAt(ofDirectory path: String) -> Date? {
+        if let attrs = cache.cachedAttrs(forPath: path) {
+            return attrs.modifiedAt
+        }
+        guard path != remotePath else { return nil }
+        let name = (path as NSString).lastPathComponent
+        let parent = (path as NSString).deletingLastPathComponent
+        return cache.cachedDirEntries(forPath: parent)?.first { $0.name == name }?.modifiedAt
     }
 
-    // MARK: - Attributes
+    // MARK: - Cache Rules & Content Cache
 
-    func getAttributes(
+    /// `path` relative to the mount root, or nil if it lies outside it.
+    private func relativePath(_ path: String) -> Substring? {
+        if path == remotePath {
+            return path[path.endIndex...]
+        }
+        let rootLength = remotePath == "/" ? 0 : remotePath.utf8.count
+        guard path.hasPrefix(remotePath),
+              path.utf8.dropFirst(rootLength).first == UInt8(ascii: "/") else { return nil }
+        return path[path.utf8.index(path.startIndex, offsetBy: rootLength + 1)...]
+    }
+
+    /// The `cache_rules` policy for `path`, or the mount-wide one.
+    private func cachePolicy(for path: String) -> CachePolicy {
+        guard let relative = relativePath(path) else { return cachePolicies.base }
+        return cachePolicies.policy(forRelativePath: relative)
+    }
+
+    private func attrTimeout(for path: String) -> TimeInterval {
+        cachePolicy(for: path).attrTimeout
+    }
+
+    private func dirTimeout(for path: String) -> TimeInterval {
+        cachePolicy(for: path).dirTimeout
+    }
+
+    /// Whether `path` matches `immutable_paths`.
+    private func isImmutable(_ path: String) -> Bool {
+        guard !immutablePatterns.isEmpty, let relative = relativePath(path) else { return false }
+        return immutablePatterns.contains { $0.matches(relative) }
+    }
+
+    private func rememberImmutableAttrs(_ attrs: SFTPFileAttributes, path: String) {
+        guard !attrs.isDirectory, !attrs.isSymlink else { return }
+        contentCache.setAttrs(attrs, forPath: path)
+    }
+
+    /// Serve a read from cached blocks, fetching whole missing blocks so later
+    /// reads of any part of them hit. Blocks of an immutable file are always
+    /// valid; those of other files only for the size and mtime in the
+    /// attribute cache. With `readAhead`, the blocks after the read are
+    /// fetched once it has been answered.
+    private func readThroughContentCache(
+        path itemPath: String,
+        offset: Int64,
+        length: Int,
+        into buffer: FSMutableFileDataBuffer,
+        immutable: Bool,
+        policy: CachePolicy,
+        replyHandler reply: @escaping (Int, Error?) -> Void
+    ) {
+        guard offset >= 0 else {
+            reply(0, POSIXError(.EINVAL))
+            return
+        }
+        let knownAttrs = immutable ? contentCache.attrs(forPath: itemPath) : cache.cachedAttrs(forPath: itemPath)
+        if immutable || knownAttrs != nil {
+            let version = immutable ? nil : knownAttrs.map(ContentCache.Version.init)
+            let cached = buffer.withUnsafeMutableBytes { dst in
+                copyCachedBlocks(offset: UInt64(offset), length: length, into: dst) { index in
+                    self.contentCache.block(path: itemPath, index: index, version: version)
+                }
+            }
+            if let cached {
+                reply(cached, nil)
+                return
+            }
+        }
+
+        enqueueReadOperation(path: itemPath, length: length, onError: { error in
+            self.recordIfAborted(error, .read)
+            Log.volume.notice("read failed for \(itemPath, privacy: .public): \(error.localizedDescription, privacy: .public)")
+            reply(0, POSIXError(Self.posixCode(from: error)))
+        }) { session, token in
+            var attrs = immutable ? self.contentCache.attrs(forPath: itemPath) : self.cache.cachedAttrs(forPath: itemPath)
+            if !immutable, attrs == nil {
+                let fetched = try self.withAutoReconnect(session) {
+                    try session.stat(path: itemPath)
+                }
+                attrs = policy.attrTimeout > 0
+                    ? self.cache.setAttrs(fetched, forPath: itemPath, timeout: policy.attrTimeout)
+                    : fetched
+            }
+            let version = immutable ? nil : attrs.map(ContentCache.Version.init)
+            let blockSize = self.contentCache.blockSize
+            let fetchBlock = { (index: UInt64) throws -> Data in
+                if let block = self.contentCache.block(path: itemPath, index: index, version: version) {
+                    return block
+                }
+                let block = try self.withAutoReconnect(session) {
+                    try session.readFile(path: itemPath, offset: index * UInt64(blockSize), length: blockSize)
+                }
+                self.contentCache.setBlock(block, path: itemPath, index: index, version: version)
+                return block
+            }
+            let bytesRead = try buffer.withUnsafeMutableBytes { dst in
+                try self.copyCachedBlocks(offset: UInt64(offset), length: length, into: dst) { try fetchBlock($0) } ?? 0
+            }
+            reply(bytesRead, nil)
+
+            guard policy.readAhead > 0, bytesRead > 0 else { return }
+            let start = UInt64(offset) + UInt64(bytesRead)
+            var end = start + UInt64(policy.readAhead)
+            if let size = attrs?.size {
+                end = min(end, size)
+            }
+            self.readAhead(path: itemPath, from: start / UInt64(blockSize), end: end, version: version)
+        }
+    }
+
+    /// Fetch the blocks of `path` from block `index` up to byte `end` into the
+    /// content cache, one block per speculative read operation. Each block is
+    /// issued only when the previous one has landed and a read slot is free
+    /// right away; the rest of the window is dropped otherwise, so read-ahead
+    /// holds at most one slot and never waits in front of foreground reads.
+    /// One window per file is in flight at a time.
+    private func readAhead(path: String, from index: UInt64, end: UInt64, version: ContentCache.Version?) {
+        readAheadLock.lock()
+        let started = readAheadPaths.insert(path).inserted
+        readAheadLock.unlock()
+        guard started else { return }
+        readAheadBlock(path: path, index: index, end: end, version: version)
+    }
+
+    private func readAheadBlock(path: String, index first: UInt64, end: UInt64, version: ContentCache.Version?) {
+        let blockSize = contentCache.blockSize
+        var index = first
+        while index * UInt64(blockSize) < end, contentCache.block(path: path, index: index, version: version) != nil {
+            index += 1
+        }
+        guard index * UInt64(blockSize) < end else {
+            finishReadAhead(path)
+            return
+        }
+        enqueueReadOperation(path: path, length: blockSize, speculative: true, onError: { error in
+            Log.volume.debug("Read-ahead stopped for \(path, privacy: .public): \(error.localizedDescription, privacy: .public)")
+            self.finishReadAhead(path)
+        }) { [index] session, _ in
+            let block = try self.withAutoReconnect(session) {
+                try session.readFile(path: path, offset: index * UInt64(blockSize), length: blockSize)
+            }
+            self.contentCache.setBlock(block, path: path, index: index, version: version)
+            guard block.count == blockSize else {
+                self.finishReadAhead(path)
+                return
+            }
+            self.readAheadBlock(path: path, index: index + 1, end: end, version: version)
+        }
+    }
+
+    private func finishReadAhead(_ path: String) {
+        readAheadLock.lock()
+        readAheadPaths.remove(path)
+        readAheadLock.unlock()
+    }
+
+    /// Copy up to `length` bytes at `offset` out of the blocks `block` returns.
+    /// - Returns: the bytes copied, short only at end of file, or nil as soon
+    ///   as `block` returns nil.
+    private func copyCachedBlocks(
+        offset: UInt64,
+        length: Int,
+        into dst: UnsafeMutableRawBufferPointer,
+        block: (UInt64) throws -> Data?
+    ) rethrows -> Int? {
+        let blockSize = UInt64(contentCache.blockSize)
+        let end = offset + UInt64(min(length, dst.count, Self.defaultIOSize))
+        var position = offset
+        var copied = 0
+        while position < end {
+            let index = position / blockSize
+            guard let data = try block(index) else { return nil }
+            let within = Int(position - index * blockSize)
+            guard within < data.count else { break }
+            let count = min(data.count - within, Int(end - position))
+            data.withUnsafeBytes { src in
+                UnsafeMutableRawBufferPointer(rebasing: dst[copied..<copied + count])
+                    .copyMemory(from: UnsafeRawBufferPointer(rebasing: src[within..<within + count]))
+            }
+            copied += count
+            position += UInt64(count)
+            if data.count < Int(blockSize) { break }
+        }
+        return copied
+    }
+
+    // MARK: - Git Index Prefetch
+
+    /// Follow git's reads of `.git/index` and list the directories of the
+    /// tracked paths ahead of the stats `git status` is about to send.
+    private func prefetchFromIndexRead(path: String, offset: Int64, data: Data) {
+        for directory in indexPrefetch.follow(indexPath: path, offset: offset, data: data) {
+            prefetchDirectory(directory)
+        }
+    }
+
+    /// List a directory behind the current primary-session work unless its
+    /// listing is still cached. Failures just leave it to be listed on demand.
+    private func prefetchDirectory(_ directory: String) {
+        enqueueSFTPOperation(.metadata, onError: { error in
+            Log.volume.debug("Index prefetch failed for \(directory, privacy: .public): \(error.localizedDescription, privacy: .public)")
+            self.finishPrefetch()
+        }) {
+            if self.cache.cachedDirEntries(forPath: directory) == nil {
+                try self.relistDirectory(directory)
+            }
+            self.finishPrefetch()
+        }
+    }
+
+    private func finishPrefetch() {
+        if let next = indexPrefetch.finish() {
+            prefetchDirectory(next)
+        }
+    }
+
+    // MARK: - Degraded Mode
+
+    /// True while reconnecting with `degraded_mode=stale`: cached metadata is
+    /// served regardless of TTL and mutations fail fast with EAGAIN.
+    private var isDegraded: Bool {
+        mountOptions.degradedMode == .stale && healthMonitor.state == .reconnecting
+    }
+
+    // MARK: - Write Journal
+
+    private func hasJournaledWrites(_ path: String) -> Bool {
+        writeJournal?.hasPending(path: path) ?? false
+    }
+
+    /// Journal a write instead of sending it: while reconnecting, or while
+    /// earlier journaled writes to the same file are still waiting for replay.
+    private func journalWrite(_ data: Data, path: String, offset: Int64, journal: WriteJournal) -> WriteJournal.AppendResult {
+        let reconnecting = healthMonitor.state == .reconnecting
+        let known = cache.staleAttrs(forPath: path)
+        let result = journal.append(
+            path: path,
+            offset: UInt64(offset),
+            data: data,
+            baseline: known.map { WriteJournal.Baseline(size: $0.size, modifiedAt: $0.modifiedAt) },
+            onlyIfPending: !reconnecting
+        )
+        guard result == .journaled else { return result }
+
+        // Keep the cached size in step with acknowledged data so a stat while
+        // disconnected does not report the file shrinking back.
+        recordLocalWrite(path, end: UInt64(offset) + UInt64(data.count))
+        return result
+    }
+
+    /// Replay journaled writes on the primary session, oldest first, ahead of
+    /// any operation parked during the reconnect.
+    ///
+    /// Before a file's first record is replayed its remote size and mtime are
+    /// compared with what was known when the write was journaled; a mismatch
+    /// means someone else changed the file while disconnected. The conflict is
+    /// logged and the local writes still win, as they would have had the
+    /// connection stayed up. Replay stops at the first connection error and
+    /// resumes after the next reconnect.
+    private func replayWriteJournal() {
+        guard let writeJournal, !writeJournal.isEmpty else { return }
+        sftpQueue.async(execute: DispatchWorkItem(block: {
+            var replayed = 0
+            var failed = 0
+            while let next = writeJournal.first() {
+                let record = next.record
+                guard next.data.count == record.length else {
+                    Log.volume.error("Write journal record for \(record.path, privacy: .public) at offset \(record.offset, privacy: .public) is truncated (\(next.data.count, privacy: .public) of \(record.length, privacy: .public) bytes), dropping it: data lost")
+                    failed += 1
+                    writeJournal.removeFirst()
+                    self.invalidateCache(record.path, includeParent: false)
+                    continue
+                }
+                var written = 0
+                do {
+                    if let baseline = next.baseline {
+                        let remote = try self.withPrimaryReconnect { try self.sftp.stat(path: record.path) }
+                        if remote.size != baseline.size || remote.modifiedAt != baseline.modifiedAt {
+                            Log.volume.error("Write journal conflict for \(record.path, privacy: .public): remote changed while disconnected (size \(baseline.size, privacy: .public) -> \(remote.size, privacy: .public)), replaying local writes over it")
+                        }
+                    }
+                    while written < next.data.count {
+                        let chunk = next.data.subdata(in: written..<min(written + Self.defaultIOSize, next.data.count))
+                        let n = try self.withPrimaryReconnect {
+                            try self.sftp.writeFile(path: record.path, offset: record.offset + UInt64(written), data: chunk)
+                        }
+                        guard n > 0 else { throw POSIXError(.EIO) }
+                        written += n
+                    }
+                    replayed += 1
+                } catch is ReconnectPending {
+                    // The server may hold a prefix; the whole record is rewritten after the reconnect.
+                    Log.volume.notice("Write journal replay interrupted, \(replayed, privacy: .public) records replayed so far")
+                    return
+                } catch {
+                    Log.volume.error("Write journal replay failed for \(record.path, privacy: .public) at offset \(record.offset, privacy: .public) after writing \(written, privacy: .public) of \(next.data.count, privacy: .public) bytes, dropping record: data lost: \(error.localizedDescription, privacy: .public)")
+                    failed += 1
+                }
+                writeJournal.removeFirst()
+                self.invalidateCache(record.path, includeParent: false)
+            }
+            if failed > 0 {
+                Log.volume.error("Write journal replayed \(replayed, privacy: .public) records, \(failed, privacy: .public) failed and were dropped")
+            } else {
+                Log.volume.notice("Write journal replayed \(replayed, privacy: .public) records")
+            }
+        }))
+    }
+
+    // MARK: - Volume Lifecycle
+
+    func mount(
+        options: FSTaskOptions,
+        replyHandler reply: @escaping (Error?) -> Void
+    ) {
+        reply(nil)
+    }
+
+    func unmount(replyHandler reply: @escaping () -> Void) {
+        disconnectAllSessions()
+        reply()
+    }
+
+    func synchronize(
+        flags: FSSyncFlags,
+        replyHandler reply: @escaping (Error?) -> Void
+    ) {
+        enqueueSFTPOperation(.sync, onError: { error in
+            Log.volume.notice("synchronize failed: \(error.localizedDescription, privacy: .public)")
+            reply(POSIXError(Self.posixCode(from: error)))
+        }) {
+            try self.syncAllWriteHandlesAcrossSessions()
+            self.cache.reconcileAllLocalWrites(keeping: self.hasJournaledWrites)
+            reply(nil)
+        }
+    }
+
+    // MARK: - Activate / Deactivate
+
+    func activate(
+        options: FSTaskOptions,
+        replyHandler reply: @escaping (FSItem?, Error?) -> Void
+    ) {
+        // Register the root item
+        let (rootItem, _) = item(forPath: remotePath)
+        reply(rootItem, nil)
+    }
+
+    func deactivate(
+        options: FSDeactivateOptions,
+        replyHandler reply: @escaping (Error?) -> Void
+    ) {
+        disconnectAllSessions()
+        reply(nil)
+    }
+
+    // MARK: - Lookup
+
+    func lookupItem(
+        named name: FSFileName,
+        inDirectory directory: FSItem,
+        replyHandler reply: @escaping (FSItem?, FSFileName?, Error?) -> Void
+    ) {
+        guard let childName = name.string else {
+            reply(nil, nil, POSIXError(.ENOENT))
+            return
+        }
+        guard let fullPath = childPath(directory: directory, name: childName) else {
+            reply(nil, nil, POSIXError(.ENOENT))
+            return
+        }
+
+        if isDegraded, cache.staleAttrs(forPath: fullPath) != nil {
+            let (childItem, _) = item(forPath: fullPath)
+            reply(childItem, name, nil)
+            return
+        }
+        if cache.isKnownMissing(fullPath) {
+            reply(nil, nil, POSIXError(.ENOENT))
+            return
+        }
+
+        coalescedMetadata(statFlights, path: fullPath, fetch: { try self.cachedStat(path: fullPath) }) { result in
+            switch result {
+            case .success:
+                let (childItem, _) = self.item(forPath: fullPath)
+                reply(childItem, name, nil)
+            case .failure(let error):
+                let code = Self.posixCode(from: error, fallback: .ENOENT)
+                let negativeTimeout = self.cachePolicy(for: fullPath).negativeTimeout
+                if code == .ENOENT, negativeTimeout > 0 {
+                    self.cache.setMissing(forPath: fullPath, timeout: negativeTimeout)
+                }
+                Log.volume.notice("lookupItem failed for \(fullPath, privacy: .public): \(error.localizedDescription, privacy: .public)")
+                reply(nil, nil, POSIXError(code))
+            }
+        }
+    }
+
+    func reclaimItem(
+        _ item: FSItem,
+        replyHandler reply: @escaping (Error?) -> Void
+    ) {
+        untrack(item)
+        reply(nil)
+    }
+
+    // MARK: - Attributes
+
+    func getAttributes(
         _ desiredAttributes: FSItem.GetAttributesRequest,
         of item: FSItem,
         replyHandler reply: @escaping (FSItem.Attributes?, Error?) -> Void
@@ -575,17 +1703,16 @@ final class SSHMountVolume: FSVolume,
             return
         }
 
-        enqueueSFTPOperation(onTimeout: {
-            reply(nil, POSIXError(.EAGAIN))
-        }) {
-            do {
-                let sftpAttrs = try self.cachedStat(path: itemPath)
-                let id = self.itemID(forPath: itemPath)
-                let parentPath = (itemPath as NSString).deletingLastPathComponent
-                let parentID = self.itemID(forPath: parentPath)
-                let attrs = self.fsAttributes(from: sftpAttrs, itemID: id, parentID: parentID)
-                reply(attrs, nil)
-            } catch {
+        if isDegraded, let sftpAttrs = cache.staleAttrs(forPath: itemPath) {
+            reply(fsAttributes(from: sftpAttrs, forPath: itemPath), nil)
+            return
+        }
+
+        coalescedMetadata(statFlights, path: itemPath, fetch: { try self.cachedStat(path: itemPath) }) { result in
+            switch result {
+            case .success(let sftpAttrs):
+                reply(self.fsAttributes(from: sftpAttrs, forPath: itemPath), nil)
+            case .failure(let error):
                 Log.volume.notice("getAttributes failed for \(itemPath, privacy: .public): \(error.localizedDescription, privacy: .public)")
                 reply(nil, POSIXError(Self.posixCode(from: error)))
             }
@@ -601,47 +1728,77 @@ final class SSHMountVolume: FSVolume,
             reply(nil, POSIXError(.ENOENT))
             return
         }
-
-        enqueueSFTPOperation(onTimeout: {
+        guard !isDegraded else {
             reply(nil, POSIXError(.EAGAIN))
-        }) {
-            do {
-                var attrs = LIBSSH2_SFTP_ATTRIBUTES()
-                attrs.flags = 0
+            return
+        }
 
-                if newAttributes.isValid(.mode) {
-                    attrs.permissions = UInt(newAttributes.mode)
-                    attrs.flags |= UInt(LIBSSH2_SFTP_ATTR_PERMISSIONS)
-                }
-                if newAttributes.isValid(.uid) || newAttributes.isValid(.gid) {
-                    attrs.uid = UInt(newAttributes.uid)
-                    attrs.gid = UInt(newAttributes.gid)
-                    attrs.flags |= UInt(LIBSSH2_SFTP_ATTR_UIDGID)
-                }
-                if newAttributes.isValid(.size) {
-                    attrs.filesize = newAttributes.size
-                    attrs.flags |= UInt(LIBSSH2_SFTP_ATTR_SIZE)
-                }
-                if newAttributes.isValid(.modifyTime) || newAttributes.isValid(.accessTime) {
-                    attrs.mtime = UInt(newAttributes.modifyTime.tv_sec)
-                    attrs.atime = attrs.mtime
-                    attrs.flags |= UInt(LIBSSH2_SFTP_ATTR_ACMODTIME)
-                }
+        let onError = { (error: Error) in
+            Log.volume.notice("setAttributes failed for \(itemPath, privacy: .public): \(error.localizedDescription, privacy: .public)")
+            reply(nil, POSIXError(Self.posixCode(from: error)))
+        }
+        let apply = { (session: SFTPSession) throws -> Void in
+            var attrs = LIBSSH2_SFTP_ATTRIBUTES()
+            attrs.flags = 0
 
-                try self.withPrimaryReconnect { try self.sftp.setstat(path: itemPath, attrs: &attrs) }
-                self.invalidateCache(itemPath, includeParent: false)
+            if newAttributes.isValid(.mode) {
+                attrs.permissions = UInt(newAttributes.mode)
+                attrs.flags |= UInt(LIBSSH2_SFTP_ATTR_PERMISSIONS)
+            }
+            if newAttributes.isValid(.uid) || newAttributes.isValid(.gid) {
+                attrs.uid = UInt(newAttributes.uid)
+                attrs.gid = UInt(newAttributes.gid)
+                attrs.flags |= UInt(LIBSSH2_SFTP_ATTR_UIDGID)
+            }
+            if newAttributes.isValid(.size) {
+                attrs.filesize = newAttributes.size
+                attrs.flags |= UInt(LIBSSH2_SFTP_ATTR_SIZE)
+            }
+            if newAttributes.isValid(.modifyTime) || newAttributes.isValid(.accessTime) {
+                attrs.mtime = UInt(newAttributes.modifyTime.tv_sec)
+                attrs.atime = attrs.mtime
+                attrs.flags |= UInt(LIBSSH2_SFTP_ATTR_ACMODTIME)
+            }
 
-                let updated = try self.withPrimaryReconnect {
-                    try self.sftp.stat(path: itemPath)
+            let known = self.cache.cachedAttrs(forPath: itemPath)
+            try self.withAutoReconnect(session) { try session.setstat(path: itemPath, attrs: &attrs) }
+            self.invalidateCache(itemPath, includeParent: false)
+
+            // The result follows from the request when the rest is cached;
+            // only stat when it is not.
+            let updated: SFTPFileAttributes
+            var settled = true
+            if let known {
+                updated = Self.applying(attrs, to: known)
+                settled = updated.size == known.size || attrs.flags & UInt(LIBSSH2_SFTP_ATTR_ACMODTIME) != 0
+            } else {
+                self.metrics.recordMetadataRoundTrip()
+                updated = try self.withAutoReconnect(session) {
+                    try session.stat(path: itemPath)
                 }
-                let id = self.itemID(forPath: itemPath)
-                let parentPath = (itemPath as NSString).deletingLastPathComponent
-                let parentID = self.itemID(forPath: parentPath)
-                reply(self.fsAttributes(from: updated, itemID: id, parentID: parentID), nil)
-            } catch {
-                Log.volume.notice("setAttributes failed for \(itemPath, privacy: .public): \(error.localizedDescription, privacy: .public)")
-                reply(nil, POSIXError(Self.posixCode(from: error)))
             }
+            // Keep the result for the next getAttributes, unless a truncation
+            // left its mtime to be read from the server.
+            let timeout = self.attrTimeout(for: itemPath)
+            if timeout > 0, settled {
+                self.cache.setAttrs(updated, forPath: itemPath, timeout: timeout)
+            }
+            reply(self.fsAttributes(from: updated, forPath: itemPath), nil)
+        }
+
+        // A file open for writing on its write worker is changed there, through
+        // the handle and behind the writes already queued for it, so a
+        // truncation cannot overtake them.
+        if let worker = writeWorker(for: itemPath),
+           handleRegistry.holds(path: itemPath, session: worker.sftp),
+           !hasJournaledWrites(itemPath) {
+            enqueueOperation(on: worker.queue, .metadata, onError: onError) { token in
+                try apply(worker.sftp)
+            }
+            return
+        }
+        enqueueSFTPOperation(onError: onError) {
+            try apply(self.sftp)
         }
     }
 
@@ -660,62 +1817,77 @@ final class SSHMountVolume: FSVolume,
             return
         }
 
-        enqueueSFTPOperation(onTimeout: {
-            reply(verifier, POSIXError(.EAGAIN))
-        }) {
-            do {
-                let entries = try self.cachedReadDir(path: dirPath)
-                let dirID = self.itemID(forPath: dirPath)
-                var cookieCounter: UInt64 = 1
-
-                for entry in entries {
-                    if cookieCounter <= cookie.rawValue {
-                        cookieCounter += 1
-                        continue
-                    }
+        if isDegraded, let entries = cache.staleDirEntries(forPath: dirPath) {
+            packDirectoryEntries(entries, in: dirPath, startingAt: cookie, attributes: attributes, packer: packer)
+            reply(verifier, nil)
+            return
+        }
 
-                    let childPath = dirPath.hasSuffix("/")
-                        ? dirPath + entry.name
-                        : dirPath + "/" + entry.name
-                    let childID = self.itemID(forPath: childPath)
-
-                    let itemType = entry.fsItemType
-
-                    var entryAttrs: FSItem.Attributes? = nil
-                    if attributes != nil {
-                        entryAttrs = FSItem.Attributes()
-                        entryAttrs!.type = itemType
-                        entryAttrs!.fileID = FSItem.Identifier(rawValue: childID)!
-                        entryAttrs!.parentID = FSItem.Identifier(rawValue: dirID)!
-                        entryAttrs!.size = entry.size
-                        entryAttrs!.mode = entry.permissions
-                        entryAttrs!.linkCount = entry.isDirectory ? 2 : 1
-                        let mtime = timespec(tv_sec: Int(entry.modifiedAt.timeIntervalSince1970), tv_nsec: 0)
-                        entryAttrs!.modifyTime = mtime
-                        entryAttrs!.accessTime = mtime
-                    }
+        coalescedMetadata(readDirFlights, path: dirPath, fetch: { try self.cachedReadDir(path: dirPath) }) { result in
+            switch result {
+            case .success(let entries):
+                self.packDirectoryEntries(entries, in: dirPath, startingAt: cookie, attributes: attributes, packer: packer)
+                reply(verifier, nil)
+            case .failure(let error):
+                Log.volume.notice("enumerateDirectory failed for \(dirPath, privacy: .public): \(error.localizedDescription, privacy: .public)")
+                reply(verifier, POSIXError(Self.posixCode(from: error)))
+            }
+        }
+    }
 
-                    let packed = packer.packEntry(
-                        name: FSFileName(string: entry.name),
-                        itemType: itemType,
-                        itemID: FSItem.Identifier(rawValue: childID)!,
-                        nextCookie: FSDirectoryCookie(rawValue: cookieCounter),
-                        attributes: entryAttrs
-                    )
+    /// Pack listing entries after `cookie` until the packer is full.
+    private func packDirectoryEntries(
+        _ entries: [SFTPDirectoryEntry],
+        in dirPath: String,
+        startingAt cookie: FSDirectoryCookie,
+        attributes: FSItem.GetAttributesRequest?,
+        packer: FSDirectoryEntryPacker
+    ) {
+        let dirID = itemID(forPath: dirPath)
+        var cookieCounter: UInt64 = 1
 
-                    if !packed {
-                        reply(verifier, nil)
-                        return
-                    }
+        for entry in entries {
+            if cookieCounter <= cookie.rawValue {
+                cookieCounter += 1
+                continue
+            }
 
-                    cookieCounter += 1
-                }
+            let childPath = dirPath.hasSuffix("/")
+                ? dirPath + entry.name
+                : dirPath + "/" + entry.name
+            let childID = itemID(forPath: childPath)
+
+            let itemType = entry.fsItemType
+
+            var entryAttrs: FSItem.Attributes? = nil
+            if attributes != nil {
+                entryAttrs = FSItem.Attributes()
+                entryAttrs!.type = itemType
+                entryAttrs!.fileID = FSItem.Identifier(rawValue: childID)!
+                entryAttrs!.parentID = FSItem.Identifier(rawValue: dirID)!
+                entryAttrs!.size = entry.size
+                entryAttrs!.mode = entry.permissions
+                entryAttrs!.uid = entry.uid
+                entryAttrs!.gid = entry.gid
+                entryAttrs!.linkCount = entry.isDirectory ? 2 : 1
+                let mtime = timespec(tv_sec: Int(entry.modifiedAt.timeIntervalSince1970), tv_nsec: 0)
+                entryAttrs!.modifyTime = mtime
+                entryAttrs!.accessTime = mtime
+            }
 
-                reply(verifier, nil)
-            } catch {
-                Log.volume.notice("enumerateDirectory failed for \(dirPath, privacy: .public): \(error.localizedDescription, privacy: .public)")
-                reply(verifier, POSIXError(Self.posixCode(from: error)))
+            let packed = packer.packEntry(
+                name: FSFileName(string: entry.name),
+                itemType: itemType,
+                itemID: FSItem.Identifier(rawValue: childID)!,
+                nextCookie: FSDirectoryCookie(rawValue: cookieCounter),
+                attributes: entryAttrs
+            )
+
+            if !packed {
+                return
             }
+
+            cookieCounter += 1
         }
     }
 
@@ -735,27 +1907,48 @@ final class SSHMountVolume: FSVolume,
         }
 
         let mode = attributes.isValid(.mode) ? Int(attributes.mode) : 0o644
-
-        enqueueSFTPOperation(onTimeout: {
+        guard !isDegraded else {
             reply(nil, nil, POSIXError(.EAGAIN))
-        }) {
-            do {
-                try self.withPrimaryReconnect {
-                    switch type {
-                    case .directory:
-                        try self.sftp.mkdir(path: fullPath, permissions: mode)
-                    default:
-                        try self.sftp.createFile(path: fullPath, permissions: mode)
-                    }
-                }
+            return
+        }
+
+        let onError = { (error: Error) in
+            Log.volume.error("createItem failed for \(fullPath, privacy: .public): \(error.localizedDescription, privacy: .public)")
+            reply(nil, nil, POSIXError(Self.posixCode(from: error)))
+        }
 
-                self.invalidateCache(fullPath)
+        // A new file is created on the session its writes will use, and the
+        // handle stays open for them. Creating many small files then costs an
+        // OPEN per file on each write worker in parallel, instead of an OPEN
+        // and CLOSE on the primary session followed by another OPEN.
+        if type != .directory, let worker = writeWorker(for: fullPath), !hasJournaledWrites(fullPath) {
+            enqueueOperation(on: worker.queue, .metadata, onError: onError) { token in
+                try self.withWorkerReconnect(worker.sftp) {
+                    try worker.sftp.createFile(path: fullPath, permissions: mode, keepOpen: true)
+                }
+                self.recordCreated(fullPath, attrs: self.createdFileAttrs(fullPath, permissions: mode, on: worker.sftp))
                 let (newItem, _) = self.item(forPath: fullPath)
                 reply(newItem, name, nil)
-            } catch {
-                Log.volume.error("createItem failed for \(fullPath, privacy: .public): \(error.localizedDescription, privacy: .public)")
-                reply(nil, nil, POSIXError(Self.posixCode(from: error)))
             }
+            return
+        }
+
+        enqueueSFTPOperation(onError: onError) {
+            let attrs: SFTPFileAttributes?
+            switch type {
+            case .directory:
+                try self.withPrimaryReconnect { try self.sftp.mkdir(path: fullPath, permissions: mode) }
+                attrs = self.createdItemAttrs(fullPath, permissions: mode, isDirectory: true)
+            default:
+                try self.withPrimaryReconnect {
+                    try self.sftp.createFile(path: fullPath, permissions: mode, keepOpen: true)
+                }
+                attrs = self.createdFileAttrs(fullPath, permissions: mode, on: self.sftp)
+            }
+
+            self.recordCreated(fullPath, attrs: attrs)
+            let (newItem, _) = self.item(forPath: fullPath)
+            reply(newItem, name, nil)
         }
     }
 
@@ -770,27 +1963,69 @@ final class SSHMountVolume: FSVolume,
             reply(POSIXError(.ENOENT))
             return
         }
-
-        enqueueSFTPOperation(onTimeout: {
+        guard !isDegraded else {
             reply(POSIXError(.EAGAIN))
-        }) {
-            do {
-                self.releaseHandleAcrossSessions(path: fullPath)
-                try self.withPrimaryReconnect {
-                    let attrs = try self.sftp.stat(path: fullPath)
-                    if attrs.isDirectory {
-                        try self.sftp.rmdir(path: fullPath)
-                    } else {
-                        try self.sftp.remove(path: fullPath)
-                    }
+            return
+        }
+
+        let knownDirectory = knownIsDirectory(fullPath)
+        let onError = { (error: Error) in
+            Log.volume.notice("removeItem failed for \(fullPath, privacy: .public): \(error.localizedDescription, privacy: .public)")
+            reply(POSIXError(Self.posixCode(from: error)))
+        }
+
+        // Files go to the write worker that owns the path, so concurrent
+        // removals keep one request in flight per session instead of queueing
+        // behind each other on the primary session.
+        if knownDirectory == false, let worker = writeWorker(for: fullPath), !hasJournaledWrites(fullPath) {
+            enqueueOperation(on: worker.queue, .metadata, onError: onError) { token in
+                self.releaseHandleAcrossSessions(path: fullPath, on: worker.sftp)
+                try self.withWorkerReconnect(worker.sftp) {
+                    try self.removeRemote(fullPath, on: worker.sftp, knownDirectory: false)
                 }
-                self.invalidateCache(fullPath)
+                self.recordRemoved(fullPath)
                 self.untrack(item)
                 reply(nil)
-            } catch {
-                Log.volume.notice("removeItem failed for \(fullPath, privacy: .public): \(error.localizedDescription, privacy: .public)")
-                reply(POSIXError(Self.posixCode(from: error)))
             }
+            return
+        }
+
+        enqueueSFTPOperation(onError: onError) {
+            self.releaseHandleAcrossSessions(path: fullPath, on: self.sftp)
+            try self.withPrimaryReconnect {
+                try self.removeRemote(fullPath, on: self.sftp, knownDirectory: knownDirectory)
+            }
+            self.recordRemoved(fullPath)
+            self.untrack(item)
+            reply(nil)
+        }
+    }
+
+    /// Remove `path` with RMDIR or UNLINK as `knownDirectory` says, statting
+    /// only when the type is unknown or the removal failed because the path
+    /// was replaced remotely by the other type.
+    private func removeRemote(_ path: String, on session: SFTPSession, knownDirectory: Bool?) throws {
+        let remove = { (isDirectory: Bool) in
+            if isDirectory {
+                try session.rmdir(path: path)
+            } else {
+                try session.remove(path: path)
+            }
+        }
+        let statIsDirectory = {
+            self.metrics.recordMetadataRoundTrip()
+            return try session.stat(path: path).isDirectory
+        }
+        guard let knownDirectory else {
+            try remove(try statIsDirectory())
+            return
+        }
+        do {
+            try remove(knownDirectory)
+        } catch where !SFTPSession.isConnectionError(error) {
+            let isDirectory = try statIsDirectory()
+            guard isDirectory != knownDirectory else { throw error }
+            try remove(isDirectory)
         }
     }
 
@@ -810,23 +2045,51 @@ final class SSHMountVolume: FSVolume,
             reply(nil, POSIXError(.EINVAL))
             return
         }
-
-        enqueueSFTPOperation(onTimeout: {
+        guard !isDegraded else {
             reply(nil, POSIXError(.EAGAIN))
-        }) {
-            do {
-                self.releaseHandleAcrossSessions(path: srcPath)
-                self.releaseHandleAcrossSessions(path: dstPath)
-                try self.withPrimaryReconnect { try self.sftp.rename(from: srcPath, to: dstPath) }
-                self.invalidateCache(srcPath)
-                self.invalidateCache(dstPath)
-                self.untrack(item)
-                let _ = self.item(forPath: dstPath)
-                if let over = overItem { self.untrack(over) }
-                reply(destinationName, nil)
-            } catch {
-                Log.volume.notice("renameItem failed \(srcPath, privacy: .public) → \(dstPath, privacy: .public): \(error.localizedDescription, privacy: .public)")
-                reply(nil, POSIXError(Self.posixCode(from: error)))
+            return
+        }
+
+        let onError = { (error: Error) in
+            Log.volume.notice("renameItem failed \(srcPath, privacy: .public) → \(dstPath, privacy: .public): \(error.localizedDescription, privacy: .public)")
+            reply(nil, POSIXError(Self.posixCode(from: error)))
+        }
+        let rename = { () throws -> Void in
+            self.releaseHandleAcrossSessions(path: srcPath, on: self.sftp)
+            self.releaseHandleAcrossSessions(path: dstPath, on: self.sftp)
+            try self.withPrimaryReconnect { try self.sftp.rename(from: srcPath, to: dstPath) }
+            // A rename keeps type, size, mode and mtime, so the source's
+            // attributes move to the destination; only without them is it statted.
+            let moved = self.cache.cachedAttrs(forPath: srcPath) ?? self.movedItemAttrs(dstPath)
+            if moved?.isDirectory ?? (self.knownIsDirectory(srcPath) != false) {
+                self.invalidateDescendants(of: srcPath)
+                self.invalidateDescendants(of: dstPath)
+            }
+            self.recordRemoved(srcPath)
+            self.recordCreated(dstPath, attrs: moved)
+            self.untrack(item)
+            let _ = self.item(forPath: dstPath)
+            if let over = overItem { self.untrack(over) }
+            reply(destinationName, nil)
+        }
+        guard mountOptions.profile == .git else {
+            enqueueSFTPOperation(onError: onError, rename)
+            return
+        }
+
+        // A lock file may still have unsynced writes on a worker session. They
+        // are made durable there first, while sftpQueue keeps serving metadata.
+        syncWorkerHandles(paths: [srcPath, dstPath]) { error in
+            if let error {
+                onError(error)
+                return
+            }
+            self.enqueueSFTPOperation(onError: onError) {
+                try self.withPrimaryReconnect {
+                    try self.sftp.syncHandle(path: srcPath)
+                    try self.sftp.syncHandle(path: dstPath)
+                }
+                try rename()
             }
         }
     }
@@ -842,13 +2105,13 @@ final class SSHMountVolume: FSVolume,
             return
         }
 
-        enqueueSFTPOperation(onTimeout: {
-            reply(nil, POSIXError(.EAGAIN))
-        }) {
-            do {
-                let target = try self.withPrimaryReconnect { try self.sftp.readlink(path: itemPath) }
+        coalescedMetadata(readlinkFlights, path: itemPath, fetch: {
+            try self.withPrimaryReconnect { try self.sftp.readlink(path: itemPath) }
+        }) { result in
+            switch result {
+            case .success(let target):
                 reply(FSFileName(string: target), nil)
-            } catch {
+            case .failure(let error):
                 Log.volume.notice("readSymbolicLink failed for \(itemPath, privacy: .public): \(error.localizedDescription, privacy: .public)")
                 reply(nil, POSIXError(Self.posixCode(from: error)))
             }
@@ -868,19 +2131,20 @@ final class SSHMountVolume: FSVolume,
             reply(nil, nil, POSIXError(.EINVAL))
             return
         }
-
-        enqueueSFTPOperation(onTimeout: {
+        guard !isDegraded else {
             reply(nil, nil, POSIXError(.EAGAIN))
+            return
+        }
+
+        enqueueSFTPOperation(onError: { error in
+            Log.volume.error("createSymbolicLink failed for \(linkPath, privacy: .public): \(error.localizedDescription, privacy: .public)")
+            reply(nil, nil, POSIXError(Self.posixCode(from: error)))
         }) {
-            do {
-                try self.withPrimaryReconnect { try self.sftp.symlink(target: target, linkPath: linkPath) }
-                self.invalidateCache(linkPath)
-                let (newItem, _) = self.item(forPath: linkPath)
-                reply(newItem, name, nil)
-            } catch {
-                Log.volume.error("createSymbolicLink failed for \(linkPath, privacy: .public): \(error.localizedDescription, privacy: .public)")
-                reply(nil, nil, POSIXError(Self.posixCode(from: error)))
-            }
+            try self.withPrimaryReconnect { try self.sftp.symlink(target: target, linkPath: linkPath) }
+            let attrs = self.createdItemAttrs(linkPath, permissions: 0o777, size: UInt64(target.utf8.count), isSymlink: true)
+            self.recordCreated(linkPath, attrs: attrs)
+            let (newItem, _) = self.item(forPath: linkPath)
+            reply(newItem, name, nil)
         }
     }
 
@@ -901,6 +2165,12 @@ final class SSHMountVolume: FSVolume,
         modes: FSVolume.OpenModes,
         replyHandler reply: @escaping (Error?) -> Void
     ) {
+        // Close-to-open consistency for the git profile: attributes cached
+        // before this open are not trusted after it.
+        if mountOptions.profile == .git, let itemPath = path(for: item) {
+            statFlights.forget(itemPath)
+            cache.invalidateAttrs(itemPath)
+        }
         // Handles are opened lazily on first read/write via the handle cache
         reply(nil)
     }
@@ -914,27 +2184,29 @@ final class SSHMountVolume: FSVolume,
             reply(nil)
             return
         }
-        enqueueSFTPOperation(onTimeout: {
-            reply(POSIXError(.EAGAIN))
-        }) {
-            var closeError: Error?
-            do {
-                if self.mountOptions.profile == .git {
-                    try self.syncPathAcrossSessions(path: itemPath)
+        guard mountOptions.profile == .git else {
+            enqueueSFTPOperation(.sync, onError: { error in
+                reply(POSIXError(Self.posixCode(from: error)))
+            }) {
+                // Journaled writes have not reached the server yet; keep their sizes.
+                if !self.hasJournaledWrites(itemPath) {
+                    self.cache.reconcileLocalWrites(forPath: itemPath)
                 }
-            } catch {
-                closeError = error
+                self.closeHandlesAcrossSessions(path: itemPath)
+                reply(nil)
             }
+            return
+        }
 
-            self.releaseHandleAcrossSessions(path: itemPath)
-
-            if let closeError {
-                Log.volume.notice("closeItem failed for \(itemPath, privacy: .public): \(closeError.localizedDescription, privacy: .public)")
-                reply(POSIXError(Self.posixCode(from: closeError)))
-                return
+        // Closes that arrive while a batch is being committed form the next
+        // batch, which commits as a whole (group commit).
+        guard pendingCloses.add(PendingClose(path: itemPath, reply: reply)) else { return }
+        enqueueSFTPOperation(.sync, onError: { error in
+            for close in self.pendingCloses.take() {
+                close.reply(POSIXError(Self.posixCode(from: error)))
             }
-
-            reply(nil)
+        }) {
+            self.commitPendingCloses()
         }
     }
 
@@ -952,28 +2224,159 @@ final class SSHMountVolume: FSVolume,
             return
         }
 
-        enqueueReadOperation(onTimeout: {
-            reply(0, POSIXError(.EAGAIN))
-        }) { session in
-            do {
-                if offset < 0 {
-                    reply(0, POSIXError(.EINVAL))
-                    return
+        // Reads of .git/index feed the listing prefetch, which only the plain
+        // path below does; hedged or cached reads would bypass it.
+        let feedsIndexPrefetch = mountOptions.profile == .git && mountOptions.cacheTimeout > 0
+            && IndexPrefetch.isIndex(itemPath)
+
+        if !feedsIndexPrefetch, !hasJournaledWrites(itemPath) {
+            let immutable = isImmutable(itemPath)
+            let policy = cachePolicy(for: itemPath)
+            if immutable || policy.contentCache {
+                readThroughContentCache(
+                    path: itemPath,
+                    offset: offset,
+                    length: length,
+                    into: buffer,
+                    immutable: immutable,
+                    policy: policy,
+                    replyHandler: reply
+                )
+                return
+            }
+        }
+
+        if !feedsIndexPrefetch, let hedgeBudget, offset >= 0, !hasJournaledWrites(itemPath) {
+            readHedged(path: itemPath, offset: offset, length: length, into: buffer, budget: hedgeBudget, replyHandler: reply)
+            return
+        }
+
+        enqueueReadOperation(path: itemPath, length: length, onError: { error in
+            self.recordIfAborted(error, .read)
+            Log.volume.notice("read failed for \(itemPath, privacy: .public): \(error.localizedDescription, privacy: .public)")
+            reply(0, POSIXError(Self.posixCode(from: error)))
+        }) { session, token in
+            if offset < 0 {
+                reply(0, POSIXError(.EINVAL))
+                return
+            }
+            let bytesRead = try buffer.withUnsafeMutableBytes { dst in
+                let readLength = min(length, dst.count, Self.defaultIOSize)
+                guard readLength > 0 else { return 0 }
+                let readOffset = UInt64(offset)
+                return try self.withAutoReconnect(session) {
+                    try session.readFile(
+                        path: itemPath,
+                        offset: readOffset,
+                        length: readLength,
+                        into: dst,
+                        cancellation: token
+                    )
                 }
-                let bytesRead = try buffer.withUnsafeMutableBytes { dst in
-                    let readLength = min(length, dst.count, Self.defaultIOSize)
-                    guard readLength > 0 else { return 0 }
-                    let readOffset = UInt64(offset)
-                    return try self.withAutoReconnect(session) {
-                        try session.readFile(path: itemPath, offset: readOffset, length: readLength, into: dst)
+            }
+            if feedsIndexPrefetch, bytesRead > 0 {
+                let data = buffer.withUnsafeMutableBytes { Data(UnsafeRawBufferPointer(rebasing: $0[..<bytesRead])) }
+                self.prefetchFromIndexRead(path: itemPath, offset: offset, data: data)
+            }
+            reply(bytesRead, nil)
+        }
+    }
+
+    /// Read through two worker sessions: if the first attempt runs past its worker's
+    /// recent p95 latency, the same range is issued on another worker and the first
+    /// successful copy is returned. Both attempts read into scratch buffers so the
+    /// loser can never touch FSKit's buffer after the reply.
+    private func readHedged(
+        path itemPath: String,
+        offset: Int64,
+        length: Int,
+        into buffer: FSMutableFileDataBuffer,
+        budget: HedgeBudget,
+        replyHandler reply: @escaping (Int, Error?) -> Void
+    ) {
+        let readLength = min(length, Self.defaultIOSize)
+        guard readLength > 0 else {
+            reply(0, nil)
+            return
+        }
+        let race = HedgedReadRace()
+        let primary = nextReadWorker()
+        let metrics = self.metrics
+        budget.recordRead()
+        metrics.recordHedgeEligibleRead()
+
+        let finish: (HedgedReadRace.Outcome) -> Void = { outcome in
+            switch outcome {
+            case .won(let data, let attempt):
+                if attempt == .hedge {
+                    metrics.recordHedgeWin()
+                }
+                let copied = buffer.withUnsafeMutableBytes { dst in
+                    data.withUnsafeBytes { src in
+                        let count = min(dst.count, src.count)
+                        if count > 0 {
+                            dst.baseAddress!.copyMemory(from: src.baseAddress!, byteCount: count)
+                        }
+                        return count
                     }
                 }
-                reply(bytesRead, nil)
-            } catch {
+                reply(copied, nil)
+            case .failed(let error):
+                self.recordIfAborted(error, .read)
                 Log.volume.notice("read failed for \(itemPath, privacy: .public): \(error.localizedDescription, privacy: .public)")
                 reply(0, POSIXError(Self.posixCode(from: error)))
+            case .superseded:
+                break
             }
         }
+
+        let attempt: (HedgedReadRace.Attempt, IOWorker) -> Void = { attempt, worker in
+            self.enqueueReadOperation(on: worker, path: itemPath, length: readLength, onError: { error in
+                finish(race.complete(attempt, .failure(error)))
+            }) { session, token in
+                guard race.shouldStart(attempt, token: token) else { return }
+                let start = Date()
+                do {
+                    var scratch = Data(count: readLength)
+                    let bytesRead = try scratch.withUnsafeMutableBytes { dst in
+                        try self.withAutoReconnect(session) {
+                            try session.readFile(
+                                path: itemPath,
+                                offset: UInt64(offset),
+                                length: readLength,
+                                into: dst,
+                                cancellation: token
+                            )
+                        }
+                    }
+                    worker.readLatency.record(milliseconds: Date().timeIntervalSince(start) * 1000)
+                    if bytesRead < scratch.count {
+                        scratch.removeSubrange(bytesRead..<scratch.count)
+                    }
+                    finish(race.complete(attempt, .success(scratch)))
+                } catch let error as ReconnectPending {
+                    // Parked with its worker and reissued once it is back.
+                    throw error
+                } catch {
+                    finish(race.complete(attempt, .failure(error)))
+                }
+            }
+        }
+
+        attempt(.primary, primary)
+
+        guard let thresholdMs = primary.readLatency.p95Milliseconds() else { return }
+        let primaryIndex = readWorkers.firstIndex { $0 === primary } ?? 0
+        let hedgeWorker = readWorkers[(primaryIndex + 1) % readWorkers.count]
+        DispatchQueue.global(qos: .utility).asyncAfter(
+            deadline: .now() + .microseconds(Int(thresholdMs * 1000)),
+            execute: DispatchWorkItem(block: {
+                guard !race.isFinished, budget.tryConsume() else { return }
+                guard race.beginHedge() else { return }
+                metrics.recordHedgeIssued()
+                attempt(.hedge, hedgeWorker)
+            })
+        )
     }
 
     func write(
@@ -990,22 +2393,36 @@ final class SSHMountVolume: FSVolume,
             reply(0, POSIXError(.EINVAL))
             return
         }
-
-        enqueueWriteOperation(path: itemPath, onTimeout: {
+        if let writeJournal {
+            switch journalWrite(contents, path: itemPath, offset: offset, journal: writeJournal) {
+            case .journaled:
+                reply(contents.count, nil)
+                return
+            case .full where writeJournal.hasPending(path: itemPath):
+                // Sending it directly would overtake the journaled writes.
+                reply(0, POSIXError(.EAGAIN))
+                return
+            case .notPending, .full:
+                break
+            }
+        }
+        guard !isDegraded else {
             reply(0, POSIXError(.EAGAIN))
-        }) { session in
-            do {
-                let writeOffset = UInt64(offset)
-                let chunk = contents.count > Self.defaultIOSize ? Data(contents.prefix(Self.defaultIOSize)) : contents
-                let written = try self.withAutoReconnect(session) {
-                    try session.writeFile(path: itemPath, offset: writeOffset, data: chunk)
-                }
-                self.invalidateCache(itemPath, includeParent: false)
-                reply(written, nil)
-            } catch {
-                Log.volume.error("write failed for \(itemPath, privacy: .public): \(error.localizedDescription, privacy: .public)")
-                reply(0, POSIXError(Self.posixCode(from: error)))
+            return
+        }
+
+        enqueueWriteOperation(path: itemPath, length: contents.count, onError: { error in
+            self.recordIfAborted(error, .write)
+            Log.volume.error("write failed for \(itemPath, privacy: .public): \(error.localizedDescription, privacy: .public)")
+            reply(0, POSIXError(Self.posixCode(from: error)))
+        }) { session, token in
+            let writeOffset = UInt64(offset)
+            let chunk = contents.count > Self.defaultIOSize ? Data(contents.prefix(Self.defaultIOSize)) : contents
+            let written = try self.withAutoReconnect(session) {
+                try session.writeFile(path: itemPath, offset: writeOffset, data: chunk, cancellation: token)
             }
+            self.recordLocalWrite(itemPath, end: writeOffset + UInt64(written))
+            reply(written, nil)
         }
     }
 
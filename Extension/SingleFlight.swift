@@ -0,0 +1,63 @@
+import Foundation
+
+/// Coalesces concurrent requests for the same key into a single execution.
+///
+/// The first caller for a key becomes the leader and receives a ticket; it must
+/// run the request and hand the result to `complete(_:with:)`. Callers that join
+/// while the request is in flight are not executed at all and receive the
+/// leader's result.
+final class SingleFlight<Key: Hashable, Value>: @unchecked Sendable {
+
+    /// An in-flight request, held by its leader.
+    final class Ticket {
+        fileprivate let key: Key
+        fileprivate var waiters: [(Result<Value, Error>) -> Void] = []
+
+        fileprivate init(key: Key) {
+            self.key = key
+        }
+    }
+
+    private let lock = NSLock()
+    private var flights: [Key: Ticket] = [:]
+
+    /// Join the request for `key`.
+    /// - Returns: a ticket if the caller is the leader, nil if it joined a request already in flight.
+    func join(_ key: Key, _ completion: @escaping (Result<Value, Error>) -> Void) -> Ticket? {
+        lock.lock()
+        if let flight = flights[key] {
+            flight.waiters.append(completion)
+            lock.unlock()
+            return nil
+        }
+        let ticket = Ticket(key: key)
+        ticket.waiters.append(completion)
+        flights[key] = ticket
+        lock.unlock()
+        return ticket
+    }
+
+    /// Deliver the leader's result to everyone who joined its request.
+    func complete(_ ticket: Ticket, with result: Result<Value, Error>) {
+        lock.lock()
+        if flights[ticket.key] === ticket {
+            flights.removeValue(forKey: ticket.key)
+        }
+        let waiters = ticket.waiters
+        ticket.waiters.removeAll()
+        lock.unlock()
+
+        for waiter in waiters {
+            waiter(result)
+        }
+    }
+
+    /// Stop new callers from joining the request in flight for `key`, e.g. after
+    /// a mutation made its result out of date. Callers already waiting still
+    /// receive it.
+    func forget(_ key: Key) {
+        lock.lock()
+        flights.removeValue(forKey: key)
+        lock.unlock()
+    }
+}
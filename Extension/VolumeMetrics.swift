@@ -0,0 +1,217 @@
+import Foundation
+import Synchronization
+
+/// Log-bucketed latency histogram in milliseconds.
+struct LatencyHistogram: Sendable {
+    static let bucketBoundsMs: [Double] = [1, 2, 5, 10, 25, 50, 100, 250, 500, 1_000, 2_500, 5_000, 10_000]
+
+    private(set) var counts = [Int](repeating: 0, count: bucketBoundsMs.count + 1)
+    private(set) var total = 0
+
+    mutating func record(milliseconds: Double) {
+        let index = Self.bucketBoundsMs.firstIndex(where: { milliseconds < $0 }) ?? Self.bucketBoundsMs.count
+        counts[index] += 1
+        total += 1
+    }
+
+    /// Upper bound of the bucket containing the given quantile (0...1).
+    func quantileUpperBound(_ quantile: Double) -> Double? {
+        guard total > 0 else { return nil }
+        let rank = Int((Double(total) * quantile).rounded(.up))
+        var seen = 0
+        for (index, count) in counts.enumerated() {
+            seen += count
+            if seen >= rank {
+                return index < Self.bucketBoundsMs.count ? Self.bucketBoundsMs[index] : .infinity
+            }
+        }
+        return .infinity
+    }
+
+    var summary: String {
+        guard total > 0 else { return "n=0" }
+        func fmt(_ q: Double) -> String {
+            guard let bound = quantileUpperBound(q) else { return "n/a" }
+            return bound.isInfinite ? ">\(Int(Self.bucketBoundsMs.last!))" : "<\(Int(bound))"
+        }
+        return "n=\(total) p50\(fmt(0.5))ms p95\(fmt(0.95))ms p99\(fmt(0.99))ms"
+    }
+}
+
+/// Volume-level counters and histograms, logged with each health snapshot.
+/// Histograms cover the interval since the previous snapshot.
+@available(macOS 26.0, *)
+final class VolumeMetrics: Sendable {
+
+    private struct State: ~Copyable {
+        var queueWait: [OperationClass: LatencyHistogram] = [:]
+        var admissionTimeouts: [OperationClass: Int] = [:]
+        var admissionOverloads: [OperationClass: Int] = [:]
+        var expiredBeforeStart: [OperationClass: Int] = [:]
+        var abortedInFlight: [OperationClass: Int] = [:]
+        var expiredWhileParked: [OperationClass: Int] = [:]
+        var speculativeDrops: [OperationClass: Int] = [:]
+        var metadataRoundTrips = 0
+        var attrHits = 0
+        var attrStaleHits = 0
+        var attrRefreshes = 0
+        var coalescedRequests = 0
+        var cacheEvictions = 0
+        var cacheSweeps = 0
+        var revalidatedUnchanged = 0
+        var revalidatedChanged = 0
+        var hedgeEligibleReads = 0
+        var hedgesIssued = 0
+        var hedgeWins = 0
+    }
+
+    private let state = Mutex(State())
+
+    func recordQueueWait(_ operationClass: OperationClass, milliseconds: Double) {
+        state.withLock { state in
+            state.queueWait[operationClass, default: LatencyHistogram()].record(milliseconds: milliseconds)
+        }
+    }
+
+    func recordAdmissionRejected(_ operationClass: OperationClass, _ rejection: OperationScheduler.Rejection) {
+        state.withLock { state in
+            switch rejection {
+            case .deadlineExpired:
+                state.admissionTimeouts[operationClass, default: 0] += 1
+            case .overloaded:
+                state.admissionOverloads[operationClass, default: 0] += 1
+            case .busy:
+                state.speculativeDrops[operationClass, default: 0] += 1
+            }
+        }
+    }
+
+    /// Operation reached the front of its queue after its deadline and was dropped.
+    func recordExpiredBeforeStart(_ operationClass: OperationClass) {
+        state.withLock { state in
+            state.expiredBeforeStart[operationClass, default: 0] += 1
+        }
+    }
+
+    /// Transfer was cancelled between chunks after its deadline passed.
+    func recordAbortedInFlight(_ operationClass: OperationClass) {
+        state.withLock { state in
+            state.abortedInFlight[operationClass, default: 0] += 1
+        }
+    }
+
+    /// Operation was parked for a reconnect that did not finish before its deadline.
+    func recordExpiredWhileParked(_ operationClass: OperationClass) {
+        state.withLock { state in
+            state.expiredWhileParked[operationClass, default: 0] += 1
+        }
+    }
+
+    /// A stat or directory listing was sent to the server.
+    func recordMetadataRoundTrip() {
+        state.withLock { $0.metadataRoundTrips += 1 }
+    }
+
+    /// A stat answered from a fresh cache entry.
+    func recordAttrCacheHit() {
+        state.withLock { $0.attrHits += 1 }
+    }
+
+    /// A stat answered from an expired entry within the grace window.
+    func recordAttrCacheStaleHit() {
+        state.withLock { $0.attrStaleHits += 1 }
+    }
+
+    /// A background refresh was issued for a stale entry.
+    func recordAttrCacheRefresh() {
+        state.withLock { $0.attrRefreshes += 1 }
+    }
+
+    /// A metadata request joined one already in flight instead of being sent.
+    func recordCoalescedRequest() {
+        state.withLock { $0.coalescedRequests += 1 }
+    }
+
+    /// Cache entries dropped over budget or swept after expiry.
+    func recordCacheEvictions(evicted: Int, swept: Int) {
+        state.withLock { state in
+            state.cacheEvictions += evicted
+            state.cacheSweeps += swept
+        }
+    }
+
+    /// Cache entries from before a reconnect that were checked against the server.
+    func recordCacheRevalidation(unchanged: Int, changed: Int) {
+        state.withLock { state in
+            state.revalidatedUnchanged += unchanged
+            state.revalidatedChanged += changed
+        }
+    }
+
+    func recordHedgeEligibleRead() {
+        state.withLock { $0.hedgeEligibleReads += 1 }
+    }
+
+    func recordHedgeIssued() {
+        state.withLock { $0.hedgesIssued += 1 }
+    }
+
+    /// The hedge finished before the original attempt.
+    func recordHedgeWin() {
+        state.withLock { $0.hedgeWins += 1 }
+    }
+
+    /// Log the current interval and reset the histograms.
+    func emitSnapshot() {
+        let lines = state.withLock { state -> [String] in
+            var lines = OperationClass.allCases.compactMap { operationClass -> String? in
+                let histogram = state.queueWait[operationClass] ?? LatencyHistogram()
+                let timeouts = state.admissionTimeouts[operationClass] ?? 0
+                let overloads = state.admissionOverloads[operationClass] ?? 0
+                let expired = state.expiredBeforeStart[operationClass] ?? 0
+                let aborted = state.abortedInFlight[operationClass] ?? 0
+                let parkedExpired = state.expiredWhileParked[operationClass] ?? 0
+                let dropped = state.speculativeDrops[operationClass] ?? 0
+                guard histogram.total > 0 || timeouts > 0 || overloads > 0 || expired > 0 || aborted > 0 || parkedExpired > 0 || dropped > 0 else {
+                    return nil
+                }
+                return "\(operationClass.description): \(histogram.summary) timeouts=\(timeouts) overloads=\(overloads) expired=\(expired) aborted=\(aborted) parkedExpired=\(parkedExpired) dropped=\(dropped)"
+            }
+            if state.metadataRoundTrips > 0 || state.attrHits > 0 || state.attrStaleHits > 0
+                || state.coalescedRequests > 0 || state.cacheEvictions > 0 || state.cacheSweeps > 0
+                || state.revalidatedUnchanged > 0 || state.revalidatedChanged > 0 {
+                lines.append(
+                    "cache: roundTrips=\(state.metadataRoundTrips) hits=\(state.attrHits) staleHits=\(state.attrStaleHits) refreshes=\(state.attrRefreshes) coalesced=\(state.coalescedRequests) evicted=\(state.cacheEvictions) swept=\(state.cacheSweeps) revalidated=\(state.revalidatedUnchanged) changed=\(state.revalidatedChanged)"
+                )
+            }
+            if state.hedgeEligibleReads > 0 {
+                let rate = Double(state.hedgesIssued) / Double(state.hedgeEligibleReads) * 100
+                lines.append(
+                    "hedge: reads=\(state.hedgeEligibleReads) issued=\(state.hedgesIssued) (\(String(format: "%.1f", rate))%) wins=\(state.hedgeWins)"
+                )
+            }
+            state.metadataRoundTrips = 0
+            state.attrHits = 0
+            state.attrStaleHits = 0
+            state.attrRefreshes = 0
+            state.coalescedRequests = 0
+            state.cacheEvictions = 0
+            state.cacheSweeps = 0
+            state.revalidatedUnchanged = 0
+            state.revalidatedChanged = 0
+            state.hedgeEligibleReads = 0
+            state.hedgesIssued = 0
+            state.hedgeWins = 0
+            state.queueWait.removeAll()
+            state.admissionTimeouts.removeAll()
+            state.admissionOverloads.removeAll()
+            state.expiredBeforeStart.removeAll()
+            state.abortedInFlight.removeAll()
+            state.expiredWhileParked.removeAll()
+            state.speculativeDrops.removeAll()
+            return lines
+        }
+        guard !lines.isEmpty else { return }
+        Log.volume.notice("VolumeMetrics \(lines.joined(separator: " | "), privacy: .public)")
+    }
+}
@@ -0,0 +1,166 @@
+import Foundation
+
+/// Bounded on-disk journal of writes acknowledged while the connection is down.
+///
+/// Payloads are appended to a single file and indexed in memory; records are
+/// replayed oldest first once the session is back. Once a path has journaled
+/// writes, later writes to it are journaled too until the replay drains it, so
+/// writes to one file are never reordered.
+///
+/// The journal lives only as long as the volume: records still pending at
+/// unmount or after an extension crash are lost.
+final class WriteJournal: @unchecked Sendable {
+
+    struct Record {
+        let path: String
+        let offset: UInt64
+        let length: Int
+        /// Position of the payload in the journal file.
+        fileprivate let journalOffset: UInt64
+    }
+
+    /// Remote size and mtime last seen before the first journaled write to a path.
+    struct Baseline: Equatable {
+        let size: UInt64
+        let modifiedAt: Date
+    }
+
+    enum AppendResult {
+        case journaled
+        /// `onlyIfPending` was set and the path has nothing waiting for replay.
+        case notPending
+        /// The journal is at capacity or could not be written.
+        case full
+    }
+
+    private let lock = NSLock()
+    private let directory: URL
+    private let fileURL: URL
+    private let capacityBytes: Int
+    private var fileHandle: FileHandle?
+    private var records: [Record] = []
+    private var usedBytes = 0
+    private var pendingCounts: [String: Int] = [:]
+    private var baselines: [String: Baseline] = [:]
+
+    init(directory: URL, capacityBytes: Int) {
+        self.directory = directory
+        self.fileURL = directory.appendingPathComponent("writes.journal")
+        self.capacityBytes = capacityBytes
+    }
+
+    var isEmpty: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return records.isEmpty
+    }
+
+    func hasPending(path: String) -> Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return pendingCounts[path] != nil
+    }
+
+    /// Append a write.
+    ///
+    /// - Parameters:
+    ///   - baseline: remote attributes known before this write, kept for the
+    ///     path's first pending record to detect conflicting remote changes at replay.
+    ///   - onlyIfPending: journal only if the path already has pending records.
+    ///     Checked atomically with the append, so a write cannot slip past a
+    ///     replay that is draining the same path.
+    func append(path: String, offset: UInt64, data: Data, baseline: Baseline?, onlyIfPending: Bool) -> AppendResult {
+        lock.lock()
+        defer { lock.unlock() }
+        if onlyIfPending && pendingCounts[path] == nil {
+            return .notPending
+        }
+        guard usedBytes + data.count <= capacityBytes else { return .full }
+        do {
+            let handle = try openFileLocked()
+            let position = try handle.seekToEnd()
+            try handle.write(contentsOf: data)
+            records.append(Record(path: path, offset: offset, length: data.count, journalOffset: position))
+        } catch {
+            Log.volume.error("Write journal append failed: \(error.localizedDescription, privacy: .public)")
+            return .full
+        }
+        usedBytes += data.count
+        if pendingCounts[path] == nil, let baseline {
+            baselines[path] = baseline
+        }
+        pendingCounts[path, default: 0] += 1
+        return .journaled
+    }
+
+    /// Oldest pending record with its payload, or nil once drained.
+    /// The record stays pending until `removeFirst()`. A payload that cannot be
+    /// read back is returned short, so the replay can drop it and move on.
+    func first() -> (record: Record, data: Data, baseline: Baseline?)? {
+        lock.lock()
+        defer { lock.unlock() }
+        guard let record = records.first else { return nil }
+        var data = Data()
+        do {
+            if let handle = fileHandle {
+                try handle.seek(toOffset: record.journalOffset)
+                data = try handle.read(upToCount: record.length) ?? Data()
+            }
+        } catch {
+            Log.volume.error("Write journal read failed: \(error.localizedDescription, privacy: .public)")
+        }
+        if data.count != record.length {
+            Log.volume.error("Write journal record for \(record.path, privacy: .public) is truncated")
+        }
+        return (record, data, baselines[record.path])
+    }
+
+    /// Drop the oldest record after it was replayed or abandoned.
+    func removeFirst() {
+        lock.lock()
+        defer { lock.unlock() }
+        guard !records.isEmpty else { return }
+        let record = records.removeFirst()
+        // Only the first record of a run is checked against the remote file;
+        // later ones would see the effect of the earlier replay.
+        baselines.removeValue(forKey: record.path)
+        if let count = pendingCounts[record.path], count > 1 {
+            pendingCounts[record.path] = count - 1
+        } else {
+            pendingCounts.removeValue(forKey: record.path)
+        }
+        if records.isEmpty {
+            try? fileHandle?.truncate(atOffset: 0)
+            usedBytes = 0
+        }
+    }
+
+    /// Delete the journal and everything still pending.
+    /// - Returns: the number of records that were never replayed.
+    @discardableResult
+    func discard() -> Int {
+        lock.lock()
+        defer { lock.unlock() }
+        let dropped = records.count
+        records.removeAll()
+        pendingCounts.removeAll()
+        baselines.removeAll()
+        usedBytes = 0
+        try? fileHandle?.close()
+        fileHandle = nil
+        try? FileManager.default.removeItem(at: directory)
+        return dropped
+    }
+
+    // MARK: - Private (lock held)
+
+    private func openFileLocked() throws -> FileHandle {
+        if let fileHandle { return fileHandle }
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        FileManager.default.createFile(atPath: fileURL.path, contents: nil)
+        let handle = try FileHandle(forUpdating: fileURL)
+        try handle.truncate(atOffset: 0)
+        fileHandle = handle
+        return handle
+    }
+}
@@ -0,0 +1,117 @@
+import Foundation
+
+/// One `cache_rules` entry: cache settings for paths matching `pattern`,
+/// relative to the mount root. Rules are tried in order and the first match
+/// applies; a field left unset keeps the mount-wide value.
+///
+/// Text form: `<pattern>:<field>=<value>,...` with the fields `attr`, `dir`
+/// and `neg` (TTLs in seconds), `content` (`on`/`off`) and `readahead_kb`.
+/// Rules are separated by `;`.
+struct CacheRule: Codable, Sendable, Equatable {
+    let pattern: String
+    var attrTimeout: TimeInterval?
+    var dirTimeout: TimeInterval?
+    /// How long a failed lookup is answered with ENOENT without asking the server.
+    var negativeTimeout: TimeInterval?
+    /// Whether file data is cached, valid while the file's cached attributes are.
+    var contentCache: Bool?
+    /// Data fetched past each read into the content cache, in KiB.
+    var readAheadKB: Int?
+
+    static let readAheadKBRange = 0...16_384
+
+    init(
+        pattern: String,
+        attrTimeout: TimeInterval? = nil,
+        dirTimeout: TimeInterval? = nil,
+        negativeTimeout: TimeInterval? = nil,
+        contentCache: Bool? = nil,
+        readAheadKB: Int? = nil
+    ) {
+        self.pattern = pattern
+        self.attrTimeout = attrTimeout
+        self.dirTimeout = dirTimeout
+        self.negativeTimeout = negativeTimeout
+        self.contentCache = contentCache
+        self.readAheadKB = readAheadKB
+    }
+
+    /// Parse the text form of a rule list; an empty string is no rules.
+    static func parseList(_ text: String, timeoutRange: ClosedRange<Double>) throws -> [CacheRule] {
+        try text.split(separator: ";")
+            .map { $0.trimmingCharacters(in: .whitespaces) }
+            .filter { !$0.isEmpty }
+            .map { try parse($0, timeoutRange: timeoutRange) }
+    }
+
+    private static func parse(_ text: String, timeoutRange: ClosedRange<Double>) throws -> CacheRule {
+        guard let colon = text.lastIndex(of: ":") else {
+            throw MountError.invalidFormat("Cache rule '\(text)' has no settings")
+        }
+        let pattern = text[..<colon].trimmingCharacters(in: .whitespaces)
+        guard PathGlob(pattern) != nil else {
+            throw MountError.invalidFormat("Invalid pattern in cache rule '\(text)'")
+        }
+        var rule = CacheRule(pattern: pattern)
+        for field in text[text.index(after: colon)...].split(separator: ",") {
+            let parts = field.split(separator: "=", maxSplits: 1).map { $0.trimmingCharacters(in: .whitespaces) }
+            guard parts.count == 2 else {
+                throw MountError.invalidFormat("Invalid setting '\(field)' in cache rule '\(text)'")
+            }
+            let (name, value) = (parts[0], parts[1])
+            func seconds() throws -> TimeInterval {
+                guard let n = Double(value), timeoutRange.contains(n) else {
+                    throw MountError.invalidFormat("Invalid value for '\(name)' in cache rule '\(text)': '\(value)'")
+                }
+                return n
+            }
+            switch name {
+            case "attr":
+                rule.attrTimeout = try seconds()
+            case "dir":
+                rule.dirTimeout = try seconds()
+            case "neg":
+                rule.negativeTimeout = try seconds()
+            case "content":
+                guard value == "on" || value == "off" else {
+                    throw MountError.invalidFormat("Invalid value for 'content' in cache rule '\(text)': '\(value)'")
+                }
+                rule.contentCache = value == "on"
+            case "readahead_kb":
+                guard let n = Int(value), readAheadKBRange.contains(n) else {
+                    throw MountError.invalidFormat("Invalid value for 'readahead_kb' in cache rule '\(text)': '\(value)'")
+                }
+                rule.readAheadKB = n
+            default:
+                throw MountError.invalidFormat("Unknown setting '\(name)' in cache rule '\(text)'")
+            }
+        }
+        return rule
+    }
+
+    /// The text form `parseList` reads back.
+    var formatted: String {
+        var fields: [String] = []
+        if let attrTimeout { fields.append("attr=\(Self.formatSeconds(attrTimeout))") }
+        if let dirTimeout { fields.append("dir=\(Self.formatSeconds(dirTimeout))") }
+        if let negativeTimeout { fields.append("neg=\(Self.formatSeconds(negativeTimeout))") }
+        if let contentCache { fields.append("content=\(contentCache ? "on" : "off")") }
+        if let readAheadKB { fields.append("readahead_kb=\(readAheadKB)") }
+        return "\(pattern):\(fields.joined(separator: ","))"
+    }
+
+    /// The rule with its values brought into range, or nil if the pattern is invalid.
+    func clamped(timeoutRange: ClosedRange<Double>) -> CacheRule? {
+        guard PathGlob(pattern) != nil else { return nil }
+        var rule = self
+        rule.attrTimeout = attrTimeout.map { min(timeoutRange.upperBound, max(timeoutRange.lowerBound, $0)) }
+        rule.dirTimeout = dirTimeout.map { min(timeoutRange.upperBound, max(timeoutRange.lowerBound, $0)) }
+        rule.negativeTimeout = negativeTimeout.map { min(timeoutRange.upperBound, max(timeoutRange.lowerBound, $0)) }
+        rule.readAheadKB = readAheadKB.map { min(Self.readAheadKBRange.upperBound, max(Self.readAheadKBRange.lowerBound, $0)) }
+        return rule
+    }
+
+    private static func formatSeconds(_ value: TimeInterval) -> String {
+        value.rounded() == value ? String(Int(value)) : String(format: "%.3f", value)
+    }
+}
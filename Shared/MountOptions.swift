@@ -23,12 +23,18 @@ enum MountProfile: String, Codable, CaseIterable, Sendable {
         self == .git ? 0...8 : 1...8
     }
 
+    /// Worker sessions per direction when none are requested. The git
+    /// profile keeps all I/O on the primary session unless asked otherwise.
+    var defaultWorkers: Int {
+        self == .git ? 0 : 1
+    }
+
     var compatibilityDescription: String? {
         switch self {
         case .standard:
             nil
         case .git:
-            "Uses the primary session only, disables caches, and requires remote SFTP fsync support for close-time durability checks."
+            "Fsyncs across every session holding a file at close and before a rename, limits attribute and directory caches to one second with revalidation on open, disables degraded mode and the write journal, and requires remote SFTP fsync support for close-time durability checks."
         }
     }
 }
@@ -38,6 +44,15 @@ enum MountIOMode: String, Codable, CaseIterable, Sendable {
     case nonblocking
 }
 
+/// Behavior while the connection is reconnecting.
+enum MountDegradedMode: String, Codable, CaseIterable, Sendable {
+    /// Operations wait for the reconnect (up to their deadline).
+    case off
+    /// Lookups, attributes and listings are answered from cache, even if expired;
+    /// mutations fail fast with EAGAIN.
+    case stale
+}
+
 /// Canonical mount/runtime options used across App, CLI, and Extension.
 /// Legacy option names are intentionally unsupported.
 struct MountOptions: Codable, Sendable, Equatable {
@@ -51,8 +66,21 @@ struct MountOptions: Codable, Sendable, Equatable {
     let busyThreshold: Int
     let graceSeconds: TimeInterval
     let queueTimeoutMs: Int
+    /// End-to-end deadline for an admitted operation, after which queued work is dropped.
+    let operationTimeout: TimeInterval
+    /// Hedged reads allowed per 100 reads; 0 disables hedging. Needs two or more read workers.
+    let readHedgePercent: Int
     let cacheTimeout: TimeInterval
     let dirCacheTimeout: TimeInterval
+    /// Seconds past expiry an attribute entry is still served while it refreshes in the background; 0 disables.
+    let cacheGraceTimeout: TimeInterval
+    let degradedMode: MountDegradedMode
+    /// On-disk journal for writes issued while reconnecting, in MiB; 0 disables it.
+    let writeJournalMB: Int
+    /// Patterns of content-addressed files whose attributes and data are cached until deleted or renamed locally.
+    let immutablePaths: [String]
+    /// Per-subtree cache settings; the first rule whose pattern matches a path applies.
+    let cacheRules: [CacheRule]
     /// Session-only password auth fallback. Never persisted by UI.
     let authPassword: String?
 
@@ -66,7 +94,25 @@ struct MountOptions: Codable, Sendable, Equatable {
     static let busyThresholdRange = 1...4096
     static let graceSecondsRange: ClosedRange<Double> = 0...300
     static let queueTimeoutMsRange = 100...60_000
+    static let operationTimeoutRange: ClosedRange<Double> = 1...300
+    static let readHedgePercentRange = 0...50
     static let cacheTimeoutRange: ClosedRange<Double> = 0...300
+    /// Attribute and listing TTLs allowed in the git profile. Entries are also
+    /// refreshed on open and on every local mutation.
+    static let gitCacheTimeoutRange: ClosedRange<Double> = 0...1
+    static let writeJournalMBRange = 0...1024
+    /// Loose objects and pack files, which git never rewrites in place. Temporary
+    /// objects (`tmp_obj_*`, `tmp_pack_*`) do not match.
+    static let gitImmutablePaths = [
+        "**/.git/objects/[0-9a-f][0-9a-f]/[0-9a-f]*",
+        "**/.git/objects/pack/pack-*.pack",
+        "**/.git/objects/pack/pack-*.idx",
+        "**/.git/objects/pack/pack-*.rev",
+    ]
+
+    static func defaultImmutablePaths(for profile: MountProfile) -> [String] {
+        profile == .git ? gitImmutablePaths : []
+    }
 
     // MARK: - Defaults
 
@@ -74,8 +120,8 @@ struct MountOptions: Codable, Sendable, Equatable {
 
     init(
         profile: MountProfile = .standard,
-        readWorkers: Int = 1,
-        writeWorkers: Int = 1,
+        readWorkers: Int? = nil,
+        writeWorkers: Int? = nil,
         ioMode: MountIOMode = .blocking,
         healthInterval: TimeInterval = 5,
         healthTimeout: TimeInterval = 10,
@@ -83,14 +129,21 @@ struct MountOptions: Codable, Sendable, Equatable {
         busyThreshold: Int = 32,
         graceSeconds: TimeInterval = 20,
         queueTimeoutMs: Int = 2_000,
+        operationTimeout: TimeInterval = 30,
+        readHedgePercent: Int = 0,
         cacheTimeout: TimeInterval = 5,
         dirCacheTimeout: TimeInterval = 5,
+        cacheGraceTimeout: TimeInterval = 0,
+        degradedMode: MountDegradedMode = .off,
+        writeJournalMB: Int = 0,
+        immutablePaths: [String]? = nil,
+        cacheRules: [CacheRule] = [],
         authPassword: String? = nil
     ) {
         let normalized = MountOptions.normalize(
             profile: profile,
-            readWorkers: readWorkers,
-            writeWorkers: writeWorkers,
+            readWorkers: readWorkers ?? profile.defaultWorkers,
+            writeWorkers: writeWorkers ?? profile.defaultWorkers,
             ioMode: ioMode,
             healthInterval: healthInterval,
             healthTimeout: healthTimeout,
@@ -98,8 +151,15 @@ struct MountOptions: Codable, Sendable, Equatable {
             busyThreshold: busyThreshold,
             graceSeconds: graceSeconds,
             queueTimeoutMs: queueTimeoutMs,
+            operationTimeout: operationTimeout,
+            readHedgePercent: readHedgePercent,
             cacheTimeout: cacheTimeout,
             dirCacheTimeout: dirCacheTimeout,
+            cacheGraceTimeout: cacheGraceTimeout,
+            degradedMode: degradedMode,
+            writeJournalMB: writeJournalMB,
+            immutablePaths: immutablePaths ?? Self.defaultImmutablePaths(for: profile),
+            cacheRules: cacheRules,
             authPassword: authPassword
         )
         self = normalized
@@ -116,8 +176,15 @@ struct MountOptions: Codable, Sendable, Equatable {
         busyThreshold: Int,
         graceSeconds: TimeInterval,
         queueTimeoutMs: Int,
+        operationTimeout: TimeInterval,
+        readHedgePercent: Int,
         cacheTimeout: TimeInterval,
         dirCacheTimeout: TimeInterval,
+        cacheGraceTimeout: TimeInterval,
+        degradedMode: MountDegradedMode,
+        writeJournalMB: Int,
+        immutablePaths: [String],
+        cacheRules: [CacheRule],
         authPassword: String?
     ) {
         self.profile = profile
@@ -130,8 +197,15 @@ struct MountOptions: Codable, Sendable, Equatable {
         self.busyThreshold = busyThreshold
         self.graceSeconds = graceSeconds
         self.queueTimeoutMs = queueTimeoutMs
+        self.operationTimeout = operationTimeout
+        self.readHedgePercent = readHedgePercent
         self.cacheTimeout = cacheTimeout
         self.dirCacheTimeout = dirCacheTimeout
+        self.cacheGraceTimeout = cacheGraceTimeout
+        self.degradedMode = degradedMode
+        self.writeJournalMB = writeJournalMB
+        self.immutablePaths = immutablePaths
+        self.cacheRules = cacheRules
         self.authPassword = authPassword
     }
 
@@ -148,8 +222,15 @@ struct MountOptions: Codable, Sendable, Equatable {
         "busy_threshold",
         "grace_seconds",
         "queue_timeout_ms",
+        "op_timeout_s",
+        "read_hedge_pct",
         "cache_attr_s",
         "cache_dir_s",
+        "cache_grace_s",
+        "degraded_mode",
+        "write_journal_mb",
+        "immutable_paths",
+        "cache_rules",
         "auth_password",
     ]
 
@@ -179,14 +260,14 @@ struct MountOptions: Codable, Sendable, Equatable {
         let readWorkers = try Self.parseInt(
             dict,
             key: "read_workers",
-            defaultValue: 1,
-            range: parsedProfile == .git ? 0...8 : Self.readWorkerRange
+            defaultValue: parsedProfile.defaultWorkers,
+            range: parsedProfile.workerRange
         )
         let writeWorkers = try Self.parseInt(
             dict,
             key: "write_workers",
-            defaultValue: 1,
-            range: parsedProfile == .git ? 0...8 : Self.writeWorkerRange
+            defaultValue: parsedProfile.defaultWorkers,
+            range: parsedProfile.workerRange
         )
         let ioMode = try Self.parseEnum(
             dict,
@@ -229,6 +310,18 @@ struct MountOptions: Codable, Sendable, Equatable {
             defaultValue: 2_000,
             range: Self.queueTimeoutMsRange
         )
+        let operationTimeout = try Self.parseDouble(
+            dict,
+            key: "op_timeout_s",
+            defaultValue: 30,
+            range: Self.operationTimeoutRange
+        )
+        let readHedgePercent = try Self.parseInt(
+            dict,
+            key: "read_hedge_pct",
+            defaultValue: 0,
+            range: Self.readHedgePercentRange
+        )
         let cacheTimeout = try Self.parseDouble(
             dict,
             key: "cache_attr_s",
@@ -241,6 +334,32 @@ struct MountOptions: Codable, Sendable, Equatable {
             defaultValue: cacheTimeout,
             range: Self.cacheTimeoutRange
         )
+        let cacheGraceTimeout = try Self.parseDouble(
+            dict,
+            key: "cache_grace_s",
+            defaultValue: 0,
+            range: Self.cacheTimeoutRange
+        )
+        let degradedMode = try Self.parseEnum(
+            dict,
+            key: "degraded_mode",
+            defaultValue: MountDegradedMode.off
+        )
+        let writeJournalMB = try Self.parseInt(
+            dict,
+            key: "write_journal_mb",
+            defaultValue: 0,
+            range: Self.writeJournalMBRange
+        )
+        let immutablePaths = try Self.parseGlobs(
+            dict,
+            key: "immutable_paths",
+            defaultValue: Self.defaultImmutablePaths(for: parsedProfile)
+        )
+        let cacheRules = try CacheRule.parseList(
+            dict["cache_rules"] ?? "",
+            timeoutRange: parsedProfile == .git ? Self.gitCacheTimeoutRange : Self.cacheTimeoutRange
+        )
         let authPassword = dict["auth_password"]?.isEmpty == false ? dict["auth_password"] : nil
 
         self = Self.normalize(
@@ -254,8 +373,15 @@ struct MountOptions: Codable, Sendable, Equatable {
             busyThreshold: busyThreshold,
             graceSeconds: graceSeconds,
             queueTimeoutMs: queueTimeoutMs,
+            operationTimeout: operationTimeout,
+            readHedgePercent: readHedgePercent,
             cacheTimeout: cacheTimeout,
             dirCacheTimeout: dirCacheTimeout,
+            cacheGraceTimeout: cacheGraceTimeout,
+            degradedMode: degradedMode,
+            writeJournalMB: writeJournalMB,
+            immutablePaths: immutablePaths,
+            cacheRules: cacheRules,
             authPassword: authPassword
         )
     }
@@ -271,15 +397,22 @@ struct MountOptions: Codable, Sendable, Equatable {
         busyThreshold: Int,
         graceSeconds: TimeInterval,
         queueTimeoutMs: Int,
+        operationTimeout: TimeInterval,
+        readHedgePercent: Int,
         cacheTimeout: TimeInterval,
         dirCacheTimeout: TimeInterval,
+        cacheGraceTimeout: TimeInterval,
+        degradedMode: MountDegradedMode,
+        writeJournalMB: Int,
+        immutablePaths: [String],
+        cacheRules: [CacheRule],
         authPassword: String?
     ) -> MountOptions {
         if profile == .git {
             return MountOptions(
                 uncheckedProfile: .git,
-                readWorkers: 0,
-                writeWorkers: 0,
+                readWorkers: readWorkers.clamped(to: profile.workerRange),
+                writeWorkers: writeWorkers.clamped(to: profile.workerRange),
                 ioMode: .blocking,
                 healthInterval: 5,
                 healthTimeout: 10,
@@ -287,8 +420,15 @@ struct MountOptions: Codable, Sendable, Equatable {
                 busyThreshold: max(64, busyThreshold),
                 graceSeconds: graceSeconds.clamped(to: graceSecondsRange),
                 queueTimeoutMs: queueTimeoutMs.clamped(to: queueTimeoutMsRange),
-                cacheTimeout: 0,
-                dirCacheTimeout: 0,
+                operationTimeout: operationTimeout.clamped(to: operationTimeoutRange),
+                readHedgePercent: readHedgePercent.clamped(to: readHedgePercentRange),
+                cacheTimeout: cacheTimeout.clamped(to: gitCacheTimeoutRange),
+                dirCacheTimeout: dirCacheTimeout.clamped(to: gitCacheTimeoutRange),
+                cacheGraceTimeout: 0,
+                degradedMode: .off,
+                writeJournalMB: 0,
+                immutablePaths: immutablePaths.filter { PathGlob($0) != nil },
+                cacheRules: cacheRules.compactMap { $0.clamped(timeoutRange: gitCacheTimeoutRange) },
                 authPassword: authPassword
             )
         }
@@ -304,12 +444,73 @@ struct MountOptions: Codable, Sendable, Equatable {
             busyThreshold: busyThreshold.clamped(to: busyThresholdRange),
             graceSeconds: graceSeconds.clamped(to: graceSecondsRange),
             queueTimeoutMs: queueTimeoutMs.clamped(to: queueTimeoutMsRange),
+            operationTimeout: operationTimeout.clamped(to: operationTimeoutRange),
+            readHedgePercent: readHedgePercent.clamped(to: readHedgePercentRange),
             cacheTimeout: cacheTimeout.clamped(to: cacheTimeoutRange),
             dirCacheTimeout: dirCacheTimeout.clamped(to: cacheTimeoutRange),
+            cacheGraceTimeout: cacheGraceTimeout.clamped(to: cacheTimeoutRange),
+            degradedMode: degradedMode,
+            writeJournalMB: writeJournalMB.clamped(to: writeJournalMBRange),
+            immutablePaths: immutablePaths.filter { PathGlob($0) != nil },
+            cacheRules: cacheRules.compactMap { $0.clamped(timeoutRange: cacheTimeoutRange) },
             authPassword: authPassword
         )
     }
 
+    // MARK: - Codable
+
+    private enum CodingKeys: String, CodingKey {
+        case profile
+        case readWorkers
+        case writeWorkers
+        case ioMode
+        case healthInterval
+        case healthTimeout
+        case healthFailures
+        case busyThreshold
+        case graceSeconds
+        case queueTimeoutMs
+        case operationTimeout
+        case readHedgePercent
+        case cacheTimeout
+        case dirCacheTimeout
+        case cacheGraceTimeout
+        case degradedMode
+        case writeJournalMB
+        case immutablePaths
+        case cacheRules
+        case authPassword
+    }
+
+    /// Decode saved options, filling options added after the config was written with defaults.
+    init(from decoder: Decoder) throws {
+        let c = try decoder.container(keyedBy: CodingKeys.self)
+        let defaults = MountOptions()
+        let profile = try c.decodeIfPresent(MountProfile.self, forKey: .profile) ?? defaults.profile
+        self = Self.normalize(
+            profile: profile,
+            readWorkers: try c.decodeIfPresent(Int.self, forKey: .readWorkers) ?? profile.defaultWorkers,
+            writeWorkers: try c.decodeIfPresent(Int.self, forKey: .writeWorkers) ?? profile.defaultWorkers,
+            ioMode: try c.decodeIfPresent(MountIOMode.self, forKey: .ioMode) ?? defaults.ioMode,
+            healthInterval: try c.decodeIfPresent(TimeInterval.self, forKey: .healthInterval) ?? defaults.healthInterval,
+            healthTimeout: try c.decodeIfPresent(TimeInterval.self, forKey: .healthTimeout) ?? defaults.healthTimeout,
+            healthFailures: try c.decodeIfPresent(Int.self, forKey: .healthFailures) ?? defaults.healthFailures,
+            busyThreshold: try c.decodeIfPresent(Int.self, forKey: .busyThreshold) ?? defaults.busyThreshold,
+            graceSeconds: try c.decodeIfPresent(TimeInterval.self, forKey: .graceSeconds) ?? defaults.graceSeconds,
+            queueTimeoutMs: try c.decodeIfPresent(Int.self, forKey: .queueTimeoutMs) ?? defaults.queueTimeoutMs,
+            operationTimeout: try c.decodeIfPresent(TimeInterval.self, forKey: .operationTimeout) ?? defaults.operationTimeout,
+            readHedgePercent: try c.decodeIfPresent(Int.self, forKey: .readHedgePercent) ?? defaults.readHedgePercent,
+            cacheTimeout: try c.decodeIfPresent(TimeInterval.self, forKey: .cacheTimeout) ?? defaults.cacheTimeout,
+            dirCacheTimeout: try c.decodeIfPresent(TimeInterval.self, forKey: .dirCacheTimeout) ?? defaults.dirCacheTimeout,
+            cacheGraceTimeout: try c.decodeIfPresent(TimeInterval.self, forKey: .cacheGraceTimeout) ?? defaults.cacheGraceTimeout,
+            degradedMode: try c.decodeIfPresent(MountDegradedMode.self, forKey: .degradedMode) ?? defaults.degradedMode,
+            writeJournalMB: try c.decodeIfPresent(Int.self, forKey: .writeJournalMB) ?? defaults.writeJournalMB,
+            immutablePaths: try c.decodeIfPresent([String].self, forKey: .immutablePaths) ?? Self.defaultImmutablePaths(for: profile),
+            cacheRules: try c.decodeIfPresent([CacheRule].self, forKey: .cacheRules) ?? defaults.cacheRules,
+            authPassword: try c.decodeIfPresent(String.self, forKey: .authPassword)
+        )
+    }
+
     private static func parseInt(
         _ dict: [String: String],
         key: String,
@@ -342,6 +543,25 @@ struct MountOptions: Codable, Sendable, Equatable {
         return n
     }
 
+    /// Path patterns separated by `;`, which unlike `,` cannot occur in one;
+    /// an empty value means none.
+    static func parsePatterns(_ text: String, key: String = "immutable_paths") throws -> [String] {
+        let patterns = text.split(separator: ";").map { $0.trimmingCharacters(in: .whitespaces) }.filter { !$0.isEmpty }
+        for pattern in patterns where PathGlob(pattern) == nil {
+            throw MountError.invalidFormat("Invalid pattern for '\(key)': '\(pattern)'")
+        }
+        return patterns
+    }
+
+    private static func parseGlobs(
+        _ dict: [String: String],
+        key: String,
+        defaultValue: [String]
+    ) throws -> [String] {
+        guard let raw = dict[key] else { return defaultValue }
+        return try parsePatterns(raw, key: key)
+    }
+
     private static func parseEnum<T: RawRepresentable>(
         _ dict: [String: String],
         key: String,
@@ -372,8 +592,15 @@ struct MountOptions: Codable, Sendable, Equatable {
             "busy_threshold": String(busyThreshold),
             "grace_seconds": Self.formatSeconds(graceSeconds),
             "queue_timeout_ms": String(queueTimeoutMs),
+            "op_timeout_s": Self.formatSeconds(operationTimeout),
+            "read_hedge_pct": String(readHedgePercent),
             "cache_attr_s": Self.formatSeconds(cacheTimeout),
             "cache_dir_s": Self.formatSeconds(dirCacheTimeout),
+            "cache_grace_s": Self.formatSeconds(cacheGraceTimeout),
+            "degraded_mode": degradedMode.rawValue,
+            "write_journal_mb": String(writeJournalMB),
+            "immutable_paths": immutablePaths.joined(separator: ";"),
+            "cache_rules": cacheRules.map(\.formatted).joined(separator: ";"),
         ]
         if let password = sessionPassword ?? authPassword, !password.isEmpty {
             dict["auth_password"] = password
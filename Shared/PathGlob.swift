@@ -0,0 +1,138 @@
+import Foundation
+
+/// Shell-style pattern matched against a whole path relative to the mount root.
+///
+/// `*` and `?` match within one path component, `[...]` matches one character
+/// from a set or range (`[!...]` negates it), `**/` matches any number of
+/// leading directories, and a trailing `/**` matches a directory and
+/// everything below it. Matching walks the path's UTF-8 view without copying.
+struct PathGlob: Sendable, Equatable {
+
+    private enum Token: Equatable, Sendable {
+        case literal(UInt8)
+        case anyCharacter
+        case anyRun
+        /// `**/`: zero or more whole components.
+        case anyDirectories
+        /// Trailing `**`: the rest of the path.
+        case anyRest
+        /// Trailing `/**`: the end of the path, or a slash and anything after it.
+        case anySubpath
+        case set(negated: Bool, ranges: [ClosedRange<UInt8>])
+    }
+
+    private static let slash = UInt8(ascii: "/")
+
+    let pattern: String
+    private let tokens: [Token]
+
+    /// Nil if the pattern is empty or has an unterminated `[`.
+    init?(_ pattern: String) {
+        let bytes = Array(pattern.utf8)
+        guard !bytes.isEmpty else { return nil }
+        var tokens: [Token] = []
+        var index = 0
+        while index < bytes.count {
+            let byte = bytes[index]
+            switch byte {
+            case Self.slash where index + 3 == bytes.count && bytes[index + 1] == UInt8(ascii: "*") && bytes[index + 2] == UInt8(ascii: "*"):
+                tokens.append(.anySubpath)
+                index += 3
+            case UInt8(ascii: "*"):
+                if index + 1 < bytes.count, bytes[index + 1] == UInt8(ascii: "*") {
+                    if index + 2 == bytes.count {
+                        tokens.append(.anyRest)
+                        index += 2
+                        continue
+                    }
+                    if bytes[index + 2] == Self.slash {
+                        tokens.append(.anyDirectories)
+                        index += 3
+                        continue
+                    }
+                }
+                tokens.append(.anyRun)
+                index += 1
+            case UInt8(ascii: "?"):
+                tokens.append(.anyCharacter)
+                index += 1
+            case UInt8(ascii: "["):
+                guard let set = Self.parseSet(bytes, from: index + 1) else { return nil }
+                tokens.append(set.token)
+                index = set.next
+            default:
+                tokens.append(.literal(byte))
+                index += 1
+            }
+        }
+        self.pattern = pattern
+        self.tokens = tokens
+    }
+
+    func matches(_ path: String) -> Bool {
+        matches(path[...])
+    }
+
+    func matches(_ path: Substring) -> Bool {
+        Self.match(tokens[...], path.utf8)
+    }
+
+    /// Parse a set after its `[`.
+    /// - Returns: the set and the index after its `]`, or nil if unterminated.
+    private static func parseSet(_ bytes: [UInt8], from start: Int) -> (token: Token, next: Int)? {
+        var index = start
+        let negated = index < bytes.count && bytes[index] == UInt8(ascii: "!")
+        if negated { index += 1 }
+        var ranges: [ClosedRange<UInt8>] = []
+        // A `]` right after the opening bracket is a member, not the end.
+        while index < bytes.count, bytes[index] != UInt8(ascii: "]") || index == start + (negated ? 1 : 0) {
+            let low = bytes[index]
+            if index + 2 < bytes.count, bytes[index + 1] == UInt8(ascii: "-"), bytes[index + 2] != UInt8(ascii: "]") {
+                let high = bytes[index + 2]
+                guard low <= high else { return nil }
+                ranges.append(low...high)
+                index += 3
+            } else {
+                ranges.append(low...low)
+                index += 1
+            }
+        }
+        guard index < bytes.count else { return nil }
+        return (.set(negated: negated, ranges: ranges), index + 1)
+    }
+
+    private static func match(_ tokens: ArraySlice<Token>, _ path: Substring.UTF8View) -> Bool {
+        guard let token = tokens.first else { return path.isEmpty }
+        let rest = tokens.dropFirst()
+        switch token {
+        case .literal(let byte):
+            return path.first == byte && match(rest, path.dropFirst())
+        case .anyCharacter:
+            guard let first = path.first, first != slash else { return false }
+            return match(rest, path.dropFirst())
+        case .set(let negated, let ranges):
+            guard let first = path.first, first != slash else { return false }
+            guard ranges.contains(where: { $0.contains(first) }) != negated else { return false }
+            return match(rest, path.dropFirst())
+        case .anyRun:
+            var index = path.startIndex
+            while true {
+                if match(rest, path[index...]) { return true }
+                guard index < path.endIndex, path[index] != slash else { return false }
+                index = path.index(after: index)
+            }
+        case .anyDirectories:
+            if match(rest, path) { return true }
+            var index = path.startIndex
+            while let separator = path[index...].firstIndex(of: slash) {
+                index = path.index(after: separator)
+                if match(rest, path[index...]) { return true }
+            }
+            return false
+        case .anyRest:
+            return true
+        case .anySubpath:
+            return path.isEmpty || path.first == slash
+        }
+    }
+}